@@ -1,5 +1,6 @@
 #pragma once
 #include <smacc/component.h>
+#include <smacc/smacc_service_call_pool.h>
 #include <controller_manager_msgs/ControllerState.h>
 
 namespace smacc
@@ -44,6 +45,17 @@ public:
                            std::vector<std::string> stop_controllers,
                            Strictness strictness);
 
+    // Non blocking variants. The callbacks are called from a worker thread, with success false if the
+    // call failed or the timeout expired
+    unsigned long listControllersAsync(std::function<void(bool, const std::vector<controller_manager_msgs::ControllerState> &)> onDone,
+                                       ros::Duration timeout = ros::Duration(0));
+
+    unsigned long switchControllersAsync(std::vector<std::string> start_controllers,
+                                         std::vector<std::string> stop_controllers,
+                                         Strictness strictness,
+                                         std::function<void(bool)> onDone,
+                                         ros::Duration timeout = ros::Duration(0));
+
     boost::optional<std::string> serviceName_;
 
 private:
@@ -55,6 +67,9 @@ private:
     ros::ServiceClient srvReloadControllerLibraries;
     ros::ServiceClient srvSwitchControllers;
     ros::ServiceClient srvUnloadController;
+
+    // a single worker, so the asynchronous controller switches are applied in order
+    ServiceCallPool asyncCalls_;
 };
 }
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <smacc/component.h>
+#include <geometry_msgs/TransformStamped.h>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+#include <boost/optional.hpp>
+#include <functional>
+
+namespace smacc
+{
+namespace components
+{
+// Process wide tf2 buffer. All the instances of this component share a single tf2_ros::Buffer and a single
+// TransformListener, so /tf and /tf_static are deserialized once per process regardless of how many
+// components need transforms. Get it with requiresComponent:
+//
+//     smacc::components::CpTfListener *tfListener;
+//     this->requiresComponent(tfListener);
+class CpTfListener : public smacc::ISmaccComponent
+{
+public:
+    typedef std::function<void(const geometry_msgs::TransformStamped &)> TransformCallback;
+
+    CpTfListener();
+
+    virtual ~CpTfListener();
+
+    tf2_ros::Buffer &getBuffer();
+
+    boost::optional<geometry_msgs::TransformStamped> lookupTransform(const std::string &targetFrame, const std::string &sourceFrame,
+                                                                     ros::Time time = ros::Time(0));
+
+    // The callback is called (from the tf listener thread) every time a newer targetFrame <- sourceFrame
+    // transform becomes available, in the same way a tf2 MessageFilter notifies when a message becomes
+    // transformable. Returns an id for unsubscribeTransform.
+    unsigned long subscribeTransform(const std::string &targetFrame, const std::string &sourceFrame, TransformCallback callback);
+
+    // once it returns the callback is not executing and it will not be called again
+    void unsubscribeTransform(unsigned long subscriptionId);
+};
+} // namespace components
+} // namespace smacc
@@ -102,6 +102,7 @@ private:
 
     void messageCallback(const MessageType &msg)
     {
+        SMACC_TRACE_SCOPE_TYPE("client_callback", typeid(*this));
         if (firstMessage_)
         {
             postInitialMessageEvent(msg);
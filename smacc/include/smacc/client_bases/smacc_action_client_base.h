@@ -57,7 +57,27 @@ public:
 
     virtual void initialize() override
     {
-        client_ = std::make_shared<ActionClient>(name_);
+        if (this->hasDedicatedCallbackQueue())
+        {
+            // the action client callbacks are served by the client queue instead of the SimpleActionClient thread
+            ros::NodeHandle nh;
+            nh.setCallbackQueue(this->getCallbackQueue());
+            client_ = std::make_shared<ActionClient>(nh, name_, false);
+        }
+        else
+        {
+            client_ = std::make_shared<ActionClient>(name_);
+        }
+    }
+
+    virtual bool requiresConnection() override
+    {
+        return true;
+    }
+
+    virtual bool isConnected() override
+    {
+        return client_ != nullptr && client_->isServerConnected();
     }
 
     smacc::SmaccSignal<void(const ResultConstPtr &)> onSucceeded_;
@@ -196,6 +216,7 @@ protected:
 
     void onFeedback(const FeedbackConstPtr &feedback_msg)
     {
+        SMACC_TRACE_SCOPE_TYPE("client_callback", typeid(*this));
         postFeedbackEvent(feedback_msg);
     }
 
@@ -204,6 +225,7 @@ protected:
         // auto *actionResultEvent = new EvActionResult<TDerived>();
         // actionResultEvent->client = this;
         // actionResultEvent->resultMessage = *result_msg;
+        SMACC_TRACE_SCOPE_TYPE("client_callback", typeid(*this));
 
         const auto &resultType = this->getState();
         ROS_INFO("[%s] request result: %s", this->getName().c_str(), resultType.toString().c_str());
@@ -0,0 +1,297 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+
+#pragma once
+
+#include <smacc/smacc_client.h>
+#include <smacc/smacc_state_machine.h>
+#include <smacc/smacc_signal.h>
+#include <actionlib/client/action_client.h>
+
+#include <boost/optional/optional_io.hpp>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace smacc
+{
+namespace client_bases
+{
+using namespace smacc::default_events;
+
+// Action client base for several goals in flight on the same action server (ie: batch picks), built on
+// actionlib::ActionClient goal handles. Unlike SmaccActionClientBase, sending a goal does not preempt the
+// previous ones. Every goal gets an id (returned by sendGoal) that tags its result and feedback events
+// (EvGoalSucceeded, EvGoalAborted, EvGoalPreempted, EvGoalRejected, EvGoalFeedback).
+//
+// Only the active goals are tracked, and at most maxActiveGoals_ of them: sendGoal fails over that limit.
+template <typename ActionType>
+class SmaccMultiGoalActionClient : public ISmaccClient
+{
+public:
+    ACTION_DEFINITION(ActionType);
+    typedef actionlib::ActionClient<ActionType> ActionClient;
+    typedef typename ActionClient::GoalHandle GoalHandle;
+
+    SmaccMultiGoalActionClient(std::string actionServerName)
+        : name_(actionServerName), maxActiveGoals_(16), nextGoalId_(1)
+    {
+    }
+
+    SmaccMultiGoalActionClient()
+        : name_(""), maxActiveGoals_(16), nextGoalId_(1)
+    {
+    }
+
+    virtual ~SmaccMultiGoalActionClient()
+    {
+        // the goal handles must be released before the action client
+        std::map<unsigned long, GoalHandle> goals;
+        {
+            std::lock_guard<std::mutex> lock(goalsMutex_);
+            goals.swap(goals_);
+        }
+        goals.clear();
+
+        // the action client callbacks use goalsMutex_ and goals_, that are destroyed before client_: the client is
+        // destroyed first (its subscribers wait for the callbacks in progress)
+        client_.reset();
+    }
+
+    /// rosnamespace path
+    std::string name_;
+
+    size_t maxActiveGoals_;
+
+    inline std::string getNamespace() const
+    {
+        return name_;
+    }
+
+    virtual void initialize() override
+    {
+        ros::NodeHandle nh;
+        client_ = std::make_shared<ActionClient>(nh, name_, this->getCallbackQueue());
+    }
+
+    bool isServerConnected()
+    {
+        return client_ != nullptr && client_->isServerConnected();
+    }
+
+    virtual bool requiresConnection() override
+    {
+        return true;
+    }
+
+    virtual bool isConnected() override
+    {
+        return this->isServerConnected();
+    }
+
+    // returns the goal id, or 0 if the goal could not be sent
+    unsigned long sendGoal(const Goal &goal)
+    {
+        if (!this->isServerConnected())
+        {
+            ROS_ERROR("%s [at %s]: not connected with actionserver, skipping goal request ...", getName().c_str(), getNamespace().c_str());
+            return 0;
+        }
+
+        unsigned long goalId;
+        {
+            std::lock_guard<std::mutex> lock(goalsMutex_);
+            if (goals_.size() >= maxActiveGoals_)
+            {
+                ROS_ERROR("%s [at %s]: %lu goals already active, skipping goal request ...", getName().c_str(), getNamespace().c_str(), goals_.size());
+                return 0;
+            }
+
+            goalId = nextGoalId_++;
+            goals_[goalId] = GoalHandle();
+        }
+
+        ROS_INFO_STREAM(getName() << ": sending goal " << goalId << " to actionserver located in " << this->name_);
+
+        // actionlib calls the goal callbacks with its own lock held, so goalsMutex_ is never held while calling actionlib
+        auto gh = client_->sendGoal(
+            goal,
+            [this, goalId](GoalHandle gh) { this->onTransition(goalId, gh); },
+            [this, goalId](GoalHandle gh, const FeedbackConstPtr &feedback) { this->onFeedback(goalId, feedback); });
+
+        std::lock_guard<std::mutex> lock(goalsMutex_);
+        auto it = goals_.find(goalId);
+        if (it != goals_.end()) // it may be already done
+            it->second = gh;
+
+        return goalId;
+    }
+
+    void cancelGoal(unsigned long goalId)
+    {
+        GoalHandle gh;
+        {
+            std::lock_guard<std::mutex> lock(goalsMutex_);
+            auto it = goals_.find(goalId);
+            if (it == goals_.end() || it->second.isExpired())
+                return;
+
+            gh = it->second;
+        }
+
+        ROS_INFO("Cancelling goal %lu of %s", goalId, this->getName().c_str());
+        gh.cancel();
+    }
+
+    void cancelAllGoals()
+    {
+        std::vector<GoalHandle> handles;
+        {
+            std::lock_guard<std::mutex> lock(goalsMutex_);
+            for (auto &entry : goals_)
+            {
+                if (!entry.second.isExpired())
+                    handles.push_back(entry.second);
+            }
+        }
+
+        for (auto &gh : handles)
+            gh.cancel();
+    }
+
+    size_t getActiveGoals()
+    {
+        std::lock_guard<std::mutex> lock(goalsMutex_);
+        return goals_.size();
+    }
+
+    bool isActive(unsigned long goalId)
+    {
+        std::lock_guard<std::mutex> lock(goalsMutex_);
+        return goals_.count(goalId) > 0;
+    }
+
+    smacc::SmaccSignal<void(unsigned long, const ResultConstPtr &)> onSucceeded_;
+    smacc::SmaccSignal<void(unsigned long, const ResultConstPtr &)> onAborted_;
+    smacc::SmaccSignal<void(unsigned long, const ResultConstPtr &)> onPreempted_;
+    smacc::SmaccSignal<void(unsigned long, const ResultConstPtr &)> onRejected_;
+
+    template <typename T>
+    boost::signals2::connection onSucceeded(void (T::*callback)(unsigned long, const ResultConstPtr &), T *object)
+    {
+        return this->getStateMachine()->createSignalConnection(onSucceeded_, callback, object);
+    }
+
+    template <typename T>
+    boost::signals2::connection onAborted(void (T::*callback)(unsigned long, const ResultConstPtr &), T *object)
+    {
+        return this->getStateMachine()->createSignalConnection(onAborted_, callback, object);
+    }
+
+    template <typename T>
+    boost::signals2::connection onPreempted(void (T::*callback)(unsigned long, const ResultConstPtr &), T *object)
+    {
+        return this->getStateMachine()->createSignalConnection(onPreempted_, callback, object);
+    }
+
+    template <typename T>
+    boost::signals2::connection onRejected(void (T::*callback)(unsigned long, const ResultConstPtr &), T *object)
+    {
+        return this->getStateMachine()->createSignalConnection(onRejected_, callback, object);
+    }
+
+    // event creation/posting factory functions
+    std::function<void(unsigned long, ResultConstPtr)> postSuccessEvent;
+    std::function<void(unsigned long, ResultConstPtr)> postAbortedEvent;
+    std::function<void(unsigned long, ResultConstPtr)> postPreemptedEvent;
+    std::function<void(unsigned long, ResultConstPtr)> postRejectedEvent;
+    std::function<void(unsigned long, FeedbackConstPtr)> postFeedbackEvent;
+
+    template <typename EvType>
+    void postGoalResultEvent(unsigned long goalId, ResultConstPtr result)
+    {
+        auto *ev = new EvType();
+        ev->goalId = goalId;
+        if (result != nullptr)
+            ev->resultMessage = *result;
+        this->postEvent(ev);
+    }
+
+    template <typename TObjectTag, typename TDerived>
+    void configureEventSourceTypes()
+    {
+        postSuccessEvent = [=](auto id, auto msg) { this->postGoalResultEvent<EvGoalSucceeded<TDerived, TObjectTag>>(id, msg); };
+        postAbortedEvent = [=](auto id, auto msg) { this->postGoalResultEvent<EvGoalAborted<TDerived, TObjectTag>>(id, msg); };
+        postPreemptedEvent = [=](auto id, auto msg) { this->postGoalResultEvent<EvGoalPreempted<TDerived, TObjectTag>>(id, msg); };
+        postRejectedEvent = [=](auto id, auto msg) { this->postGoalResultEvent<EvGoalRejected<TDerived, TObjectTag>>(id, msg); };
+        postFeedbackEvent = [=](auto id, auto msg) {
+            auto *ev = new EvGoalFeedback<TDerived, TObjectTag>();
+            ev->goalId = id;
+            ev->feedbackMessage = *msg;
+            this->postEvent(ev);
+        };
+    }
+
+protected:
+    std::shared_ptr<ActionClient> client_;
+
+    void onFeedback(unsigned long goalId, const FeedbackConstPtr &feedback)
+    {
+        SMACC_TRACE_SCOPE_TYPE("client_callback", typeid(*this));
+        if (postFeedbackEvent)
+            postFeedbackEvent(goalId, feedback);
+    }
+
+    void onTransition(unsigned long goalId, GoalHandle gh)
+    {
+        if (gh.getCommState() != actionlib::CommState::DONE)
+            return;
+
+        SMACC_TRACE_SCOPE_TYPE("client_callback", typeid(*this));
+        {
+            // the goal stops being tracked. The handle received as parameter keeps it alive during this callback
+            std::lock_guard<std::mutex> lock(goalsMutex_);
+            if (!goals_.erase(goalId))
+                return; // already reported
+        }
+
+        auto terminalState = gh.getTerminalState();
+        auto result = gh.getResult();
+        ROS_INFO("[%s] goal %lu result: %s", this->getName().c_str(), goalId, terminalState.toString().c_str());
+
+        switch (terminalState.state_)
+        {
+        case actionlib::TerminalState::SUCCEEDED:
+            onSucceeded_(goalId, result);
+            if (postSuccessEvent)
+                postSuccessEvent(goalId, result);
+            break;
+        case actionlib::TerminalState::PREEMPTED:
+        case actionlib::TerminalState::RECALLED:
+            onPreempted_(goalId, result);
+            if (postPreemptedEvent)
+                postPreemptedEvent(goalId, result);
+            break;
+        case actionlib::TerminalState::REJECTED:
+            onRejected_(goalId, result);
+            if (postRejectedEvent)
+                postRejectedEvent(goalId, result);
+            break;
+        default: // ABORTED, LOST
+            onAborted_(goalId, result);
+            if (postAbortedEvent)
+                postAbortedEvent(goalId, result);
+            break;
+        }
+    }
+
+private:
+    std::mutex goalsMutex_;
+    std::map<unsigned long, GoalHandle> goals_;
+    unsigned long nextGoalId_;
+};
+} // namespace client_bases
+} // namespace smacc
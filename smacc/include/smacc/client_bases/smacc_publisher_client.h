@@ -8,6 +8,12 @@
 
 #include <smacc/smacc_client.h>
 #include <boost/optional/optional_io.hpp>
+#include <boost/make_shared.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 namespace smacc
 {
@@ -16,18 +22,27 @@ namespace client_bases
 class SmaccPublisherClient : public smacc::ISmaccClient
 {
 public:
+  // DIRECT: publish() calls ros::Publisher::publish in the caller thread (default).
+  // QUEUED_*: publish() only stores a copy of the message in a bounded send queue and a sender thread publishes it,
+  // so the caller (ie: the state machine) never waits for the serialization or the socket writes.
+  // When the send queue is full the new message is discarded (QUEUED_DROP_NEWEST) or it replaces the oldest one
+  // (QUEUED_DROP_OLDEST; with sendQueueSize 1 only the latest message is published)
+  enum class PublishMode
+  {
+    DIRECT,
+    QUEUED_DROP_NEWEST,
+    QUEUED_DROP_OLDEST
+  };
+
   boost::optional<std::string> topicName;
   boost::optional<int> queueSize;
 
-  SmaccPublisherClient()
-  {
-    initialized_ = false;
-  }
+  PublishMode publishMode;
+  int sendQueueSize;
 
-  virtual ~SmaccPublisherClient()
-  {
-    pub_.shutdown();
-  }
+  SmaccPublisherClient();
+
+  virtual ~SmaccPublisherClient();
 
   template <typename MessageType>
   void configure(std::string topicName)
@@ -53,15 +68,40 @@ public:
   template <typename MessageType>
   void publish(const MessageType &msg)
   {
-    pub_.publish(msg);
+    if (publishMode == PublishMode::DIRECT)
+    {
+      pub_.publish(msg);
+    }
+    else
+    {
+      // published as a shared pointer, so the intraprocess subscribers do not copy it again
+      boost::shared_ptr<const MessageType> copy = boost::make_shared<MessageType>(msg);
+      this->enqueue([this, copy]() { pub_.publish(copy); });
+    }
   }
 
+  // messages discarded by QUEUED_DROP_NEWEST because the send queue was full. The messages replaced in
+  // QUEUED_DROP_OLDEST mode are not counted
+  unsigned long getDroppedMessages() const;
+
 protected:
   ros::NodeHandle nh_;
   ros::Publisher pub_;
 
 private:
   bool initialized_;
+
+  // ---- queued publish modes ----
+  std::mutex sendMutex_;
+  std::condition_variable sendCondition_;
+  std::deque<std::function<void()>> sendQueue_;
+  std::thread senderThread_;
+  bool stopSender_;
+  std::atomic<unsigned long> droppedMessages_;
+
+  void enqueue(std::function<void()> sendMessage);
+
+  void senderLoop();
 };
 } // namespace client_bases
 } // namespace smacc
\ No newline at end of file
@@ -7,19 +7,34 @@
 #pragma once
 
 #include <smacc/smacc_client.h>
+#include <smacc/smacc_service_call_pool.h>
+#include <smacc/smacc_signal.h>
 #include <boost/optional/optional_io.hpp>
 
 namespace smacc
 {
 namespace client_bases
 {
+using namespace smacc::default_events;
+
 template <typename ServiceType>
 class SmaccServiceClient : public smacc::ISmaccClient
 {
 public:
+    typedef ServiceType TService;
+    typedef typename ServiceType::Request TRequest;
+    typedef typename ServiceType::Response TResponse;
+
     boost::optional<std::string> serviceName_;
 
+    // workers of the asynchronous calls (maximum amount of calls running at the same time)
+    int asyncWorkers_;
+
+    // default timeout of the asynchronous calls (zero: no timeout)
+    ros::Duration asyncTimeout_;
+
     SmaccServiceClient()
+        : asyncWorkers_(2), asyncTimeout_(0)
     {
         initialized_ = false;
     }
@@ -42,15 +57,112 @@ public:
         }
     }
 
+    virtual bool requiresConnection() override
+    {
+        return initialized_;
+    }
+
+    virtual bool isConnected() override
+    {
+        return client_.exists();
+    }
+
+    // blocking call
     bool call(ServiceType &srvreq)
     {
         return client_.call(srvreq);
     }
 
+    // Non blocking call, executed in a worker thread. Its result is notified with an EvServiceResponse or
+    // EvServiceFailure event (and the onServiceResponse/onServiceFailure signals) with the returned call id.
+    // Several calls may be outstanding.
+    unsigned long callAsync(const TRequest &request)
+    {
+        return this->callAsync(request, asyncTimeout_);
+    }
+
+    unsigned long callAsync(const TRequest &request, ros::Duration timeout)
+    {
+        if (!serviceName_)
+        {
+            ROS_ERROR("[%s] asynchronous call with no service name set. Skipping.", this->getName().c_str());
+            return 0;
+        }
+
+        if (asyncCalls_ == nullptr)
+        {
+            asyncCalls_ = std::make_shared<ServiceCallPool>(asyncWorkers_);
+        }
+
+        return asyncCalls_->call<ServiceType>(nh_.resolveName(*serviceName_), request, timeout,
+                                              [this](unsigned long callId, bool success, const TResponse &response, const std::string &error) {
+                                                  if (success)
+                                                      this->onAsyncResponse(callId, response);
+                                                  else
+                                                      this->onAsyncFailure(callId, error);
+                                              });
+    }
+
+    smacc::SmaccSignal<void(unsigned long, const TResponse &)> onServiceResponse_;
+    smacc::SmaccSignal<void(unsigned long, const std::string &)> onServiceFailure_;
+
+    template <typename T>
+    boost::signals2::connection onServiceResponse(void (T::*callback)(unsigned long, const TResponse &), T *object)
+    {
+        return this->getStateMachine()->createSignalConnection(onServiceResponse_, callback, object);
+    }
+
+    template <typename T>
+    boost::signals2::connection onServiceFailure(void (T::*callback)(unsigned long, const std::string &), T *object)
+    {
+        return this->getStateMachine()->createSignalConnection(onServiceFailure_, callback, object);
+    }
+
+    template <typename TObjectTag, typename TDerived>
+    void configureEventSourceTypes()
+    {
+        postResponseEvent_ = [=](unsigned long callId, const TResponse &response) {
+            auto *ev = new EvServiceResponse<TDerived, TObjectTag>();
+            ev->callId = callId;
+            ev->response = response;
+            this->postEvent(ev);
+        };
+
+        postFailureEvent_ = [=](unsigned long callId, const std::string &error) {
+            auto *ev = new EvServiceFailure<TDerived, TObjectTag>();
+            ev->callId = callId;
+            ev->error = error;
+            this->postEvent(ev);
+        };
+    }
+
 protected:
     ros::NodeHandle nh_;
     ros::ServiceClient client_;
     bool initialized_;
+
+    std::function<void(unsigned long, const TResponse &)> postResponseEvent_;
+    std::function<void(unsigned long, const std::string &)> postFailureEvent_;
+
+    // called from a worker thread of the asynchronous calls
+    void onAsyncResponse(unsigned long callId, const TResponse &response)
+    {
+        onServiceResponse_(callId, response);
+        if (postResponseEvent_)
+            postResponseEvent_(callId, response);
+    }
+
+    void onAsyncFailure(unsigned long callId, const std::string &error)
+    {
+        ROS_WARN("[%s] asynchronous call %lu failed: %s", this->getName().c_str(), callId, error.c_str());
+        onServiceFailure_(callId, error);
+        if (postFailureEvent_)
+            postFailureEvent_(callId, error);
+    }
+
+private:
+    // the last member: it is destroyed first, so no call result is notified to a partially destroyed client
+    std::shared_ptr<ServiceCallPool> asyncCalls_;
 };
 } // namespace client_bases
-} // namespace smacc
\ No newline at end of file
+} // namespace smacc
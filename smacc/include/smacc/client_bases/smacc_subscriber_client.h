@@ -34,6 +34,7 @@ public:
   SmaccSubscriberClient(std::string topicname)
   {
     topicName = topicname;
+    initialized_ = false;
   }
 
   virtual ~SmaccSubscriberClient()
@@ -92,12 +93,24 @@ public:
       {
         ROS_INFO_STREAM("[" << this->getName() << "] Subscribing to topic: " << topicName);
 
+        nh_.setCallbackQueue(this->getCallbackQueue());
         sub_ = nh_.subscribe(*topicName, *queueSize, &SmaccSubscriberClient<MessageType>::messageCallback, this);
         this->initialized_ = true;
       }
     }
   }
 
+  virtual bool requiresConnection() override
+  {
+    return initialized_;
+  }
+
+  // some publisher of the topic is connected
+  virtual bool isConnected() override
+  {
+    return sub_.getNumPublishers() > 0;
+  }
+
 protected:
   ros::NodeHandle nh_;
 
@@ -108,6 +121,7 @@ private:
 
   void messageCallback(const MessageType &msg)
   {
+    SMACC_TRACE_SCOPE_TYPE("client_callback", typeid(*this));
     if (firstMessage_)
     {
       postInitialMessageEvent(msg);
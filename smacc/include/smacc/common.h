@@ -28,6 +28,8 @@
 
 #include <smacc/smacc_fifo_scheduler.h>
 #include <smacc/smacc_types.h>
+#include <smacc/smacc_tracing.h>
+#include <smacc/smacc_logging.h>
 #include <smacc/introspection/introspection.h>
 
 typedef boost::statechart::processor_container<boost::statechart::fifo_scheduler<>, boost::function0<void>, std::allocator<void>>::processor_context my_context;
@@ -34,6 +34,10 @@ public:
     template <typename EventType>
     void postEvent();
 
+    // finds the component in the clients of the state machine or uses the shared state machine level instance
+    template <typename SmaccComponentType>
+    void requiresComponent(SmaccComponentType *&storage);
+
     template <typename TObjectTag, typename TDerived>
     void configureEventSourceTypes() {}
 
@@ -60,24 +60,42 @@ SmaccComponentType *ISmaccClient::createNamedComponent(std::string name, TArgs..
 
     std::shared_ptr<SmaccComponentType> ret;
 
+    // components_ is guarded by the state machine mutex: with the parallel client initialization, this may be
+    // called from an initialize() while ISmaccStateMachine::requiresComponent scans the client components
+    std::unique_lock<std::recursive_mutex> lock(this->getStateMachine()->m_mutex_);
     auto it = this->components_.find(componentkey);
 
     if (it == this->components_.end())
     {
+        lock.unlock();
+
         auto tname = demangledTypeName<SmaccComponentType>();
         ROS_DEBUG("%s smacc component is required. Creating a new instance.", tname.c_str());
+        StartupProfiler::Scope scope("component", tname);
 
+        // initialized out of the lock, it may wait for other threads (ie: ros connections)
         ret = std::shared_ptr<SmaccComponentType>(new SmaccComponentType(targs...));
         ret->setStateMachine(this->getStateMachine());
         ret->initialize(this);
 
-        this->components_[componentkey] = ret; //std::dynamic_pointer_cast<smacc::ISmaccComponent>(ret);
+        std::shared_ptr<SmaccComponentType> discarded;
+        lock.lock();
+        auto inserted = this->components_.insert(std::make_pair(componentkey, ret));
+        if (!inserted.second)
+        {
+            // another thread created the same component meanwhile, its instance is kept and this one discarded
+            // (destroyed out of the lock)
+            discarded = ret;
+            ret = dynamic_pointer_cast<SmaccComponentType>(inserted.first->second);
+        }
+        lock.unlock();
         ROS_DEBUG("%s resource is required. Done.", tname.c_str());
     }
     else
     {
-        ROS_DEBUG("%s resource is required. Found resource in cache.", demangledTypeName<SmaccComponentType>().c_str());
         ret = dynamic_pointer_cast<SmaccComponentType>(it->second);
+        lock.unlock();
+        ROS_DEBUG("%s resource is required. Found resource in cache.", demangledTypeName<SmaccComponentType>().c_str());
     }
 
     ret->template configureEventSourceTypes<TOrthogonal, TClient>();
@@ -16,4 +16,18 @@ void ISmaccComponent::postEvent(const EventType &ev)
 {
     stateMachine_->postEvent(ev);
 }
+
+template <typename SmaccComponentType>
+void ISmaccComponent::requiresComponent(SmaccComponentType *&storage)
+{
+    if (stateMachine_ == nullptr)
+    {
+        ROS_ERROR("Cannot use the requiresComponent funcionality before the component is assigned to a state machine. Try using the initialize method.");
+        storage = nullptr;
+    }
+    else
+    {
+        stateMachine_->requiresComponent(storage);
+    }
+}
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #pragma once
 #include <smacc/smacc_orthogonal.h>
 #include <smacc/smacc_client.h>
+#include <smacc/smacc_startup_profiler.h>
 #include <cassert>
 
 namespace smacc
@@ -107,6 +108,15 @@ public:
     {
     }
 
+    virtual void initialize() override
+    {
+        auto &initializer = this->getStateMachine()->getClientInitializer();
+        if (!initializer.defer(this, typeid(TClient), [this]() { this->initializeClient(); }))
+        {
+            this->initializeClient();
+        }
+    }
+
     template <typename SmaccComponentType, typename... TArgs>
     SmaccComponentType *createComponent(TArgs... targs)
     {
@@ -123,6 +133,13 @@ public:
     {
         return smacc::introspection::TypeInfo::getTypeInfoFromType<TClient>();
     }
+
+private:
+    void initializeClient()
+    {
+        StartupProfiler::Scope scope("client_initialize", demangledTypeName<TClient>());
+        TClient::initialize();
+    }
 };
 
 template <typename TOrthogonal>
@@ -144,8 +161,9 @@ public:
                  demangledTypeName<TClient>().c_str(),
                  demangledTypeName<TOrthogonal>().c_str());
 
+        StartupProfiler::Scope scope("client_creation", demangledTypeName<TClient>());
         auto client = std::make_shared<ClientHandler<TOrthogonal, TClient>>(args...);
-        this->assignClientToOrthogonal(client.get());
+        this->assignClientToOrthogonal(client.get(), typeid(TClient));
 
         client->template configureEventSourceTypes<TOrthogonal, TClient>();
 
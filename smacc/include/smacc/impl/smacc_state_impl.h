@@ -45,8 +45,7 @@ bool ISmaccState::param(std::string param_name, T &param_val, const T &default_v
 template <typename TOrthogonal, typename TBehavior, typename... Args>
 std::shared_ptr<TBehavior> ISmaccState::configure(Args &&... args)
 {
-    std::string orthogonalkey = demangledTypeName<TOrthogonal>();
-    ROS_INFO("[%s] Configuring orthogonal: %s", THIS_STATE_NAME, orthogonalkey.c_str());
+    SMACC_LOG_INFO("[{}] Configuring orthogonal: {}", typeid(*this), typeid(TOrthogonal));
 
     TOrthogonal *orthogonal = this->getOrthogonal<TOrthogonal>();
     if (orthogonal != nullptr)
@@ -58,7 +57,7 @@ std::shared_ptr<TBehavior> ISmaccState::configure(Args &&... args)
     }
     else
     {
-        ROS_ERROR("[%s] Skipping client behavior creation in orthogonal [%s]. It does not exist.", THIS_STATE_NAME, orthogonalkey.c_str());
+        ROS_ERROR("[%s] Skipping client behavior creation in orthogonal [%s]. It does not exist.", THIS_STATE_NAME, demangledTypeName<TOrthogonal>().c_str());
         return nullptr;
     }
 }
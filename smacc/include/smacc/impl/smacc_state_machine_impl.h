@@ -9,12 +9,14 @@
 #include <smacc/smacc_state_machine.h>
 
 #include <smacc/smacc_client.h>
+#include <smacc/component.h>
 #include <smacc/smacc_orthogonal.h>
 #include <smacc/smacc_state.h>
 
 #include <smacc/introspection/introspection.h>
 #include <smacc/smacc_signal_detector.h>
 #include <smacc/smacc_state_reactor.h>
+#include <smacc/smacc_startup_profiler.h>
 #include <smacc_msgs/SmaccStatus.h>
 #include <sstream>
 
@@ -67,6 +69,7 @@ void ISmaccStateMachine::createOrthogonal()
 
   if (orthogonals_.count(orthogonalkey) == 0)
   {
+    StartupProfiler::Scope scope("orthogonal", orthogonalkey);
     auto ret = std::make_shared<TOrthogonal>();
     orthogonals_[orthogonalkey] = dynamic_pointer_cast<smacc::ISmaccOrthogonal>(ret);
 
@@ -96,39 +99,38 @@ void ISmaccStateMachine::requiresComponent(SmaccComponentType *&storage)
   ROS_DEBUG("component %s is required", demangleSymbol(typeid(SmaccComponentType).name()).c_str());
   std::lock_guard<std::recursive_mutex> lock(m_mutex_);
 
-  for (auto *ortho : this->orthogonals_)
+  // components owned by the clients
+  for (auto &ortho : this->orthogonals_)
   {
-    for (ISmaccClient *client : ortho->getClients())
+    for (auto &client : ortho.second->getClients())
     {
       storage = client->getComponent<SmaccComponentType>();
-      if (storage == nullptr)
+      if (storage != nullptr)
       {
         return;
       }
     }
   }
 
-  // std::string componentkey = demangledTypeName<SmaccComponentType>();
-  // SmaccComponentType *ret;
+  // otherwise a single state machine level instance is shared by all the requesters
+  std::string componentkey = demangledTypeName<SmaccComponentType>();
+  auto it = components_.find(componentkey);
 
-  // auto it = components_.find(componentkey);
-
-  // if (it == components_.end())
-  // {
-  //     ROS_DEBUG("%s smacc component is required. Creating a new instance.", componentkey.c_str());
-
-  //     ret = new SmaccComponentType();
-  //     ret->setStateMachine(this);
-  //     components_[componentkey] = static_cast<smacc::ISmaccComponent *>(ret);
-  //     ROS_DEBUG("%s resource is required. Done.", componentkey.c_str());
-  // }
-  // else
-  // {
-  //     ROS_DEBUG("%s resource is required. Found resource in cache.", componentkey.c_str());
-  //     ret = dynamic_cast<SmaccComponentType *>(it->second);
-  // }
+  if (it == components_.end())
+  {
+    ROS_DEBUG("%s smacc component is required. Creating a new instance.", componentkey.c_str());
 
-  // storage = ret;
+    auto ret = std::make_shared<SmaccComponentType>();
+    ret->setStateMachine(this);
+    ret->initialize(nullptr);
+    components_[componentkey] = ret;
+    storage = ret.get();
+  }
+  else
+  {
+    ROS_DEBUG("%s resource is required. Found resource in cache.", componentkey.c_str());
+    storage = dynamic_cast<SmaccComponentType *>(it->second.get());
+  }
 }
 //-------------------------------------------------------------------------------------------------------
 template <typename EventType>
@@ -140,7 +142,8 @@ void ISmaccStateMachine::postEvent(EventType *ev)
   // we reach this place. Now, we propagate the events to all the state state reactors to generate
   // some more events
 
-  ROS_DEBUG_STREAM("[PostEvent entry point] " << demangleSymbol<EventType>());
+  SMACC_TRACE_INSTANT_TYPE("event_post", typeid(EventType));
+  SMACC_LOG_DEBUG("[PostEvent entry point] {}", typeid(EventType));
   auto currentstate = currentState_;
   if (currentstate != nullptr)
   {
@@ -157,6 +160,31 @@ void ISmaccStateMachine::postEvent()
   this->postEvent(ev);
 }
 
+template <typename EventType>
+void ISmaccStateMachine::postEvent(EventType *ev, ros::Duration delay)
+{
+  // keeps the event alive until it is posted (or releases it if the state machine is destroyed before)
+  boost::intrusive_ptr<EventType> event = ev;
+
+  // the lock is held until the timer id is stored, so the callback always finds its entry
+  std::lock_guard<std::mutex> lock(delayedEventsMutex_);
+  auto key = delayedEventsCounter_++;
+  delayedEvents_[key] = TimerWheel::getInstance().schedule(delay, [this, key, event]() {
+    this->postEvent(event.get());
+
+    // removed after posting: the destructor of the state machine waits for the timers it finds here
+    std::lock_guard<std::mutex> lock(delayedEventsMutex_);
+    delayedEvents_.erase(key);
+  });
+}
+
+template <typename EventType>
+void ISmaccStateMachine::postEvent(ros::Duration delay)
+{
+  auto *ev = new EventType();
+  this->postEvent(ev, delay);
+}
+
 template <typename T>
 bool ISmaccStateMachine::getGlobalSMData(std::string name, T &ret)
 {
@@ -309,8 +337,8 @@ boost::signals2::connection ISmaccStateMachine::createSignalConnection(TSmaccSig
            std::is_base_of<StateReactor, TSmaccObjectType>::value ||
            std::is_base_of<SmaccClientBehavior, TSmaccObjectType>::value)
   {
-    ROS_INFO("[StateMachine] life-time constrained smacc signal subscription created. Subscriber is %s",
-             demangledTypeName<TSmaccObjectType>().c_str());
+    SMACC_LOG_INFO("[StateMachine] life-time constrained smacc signal subscription created. Subscriber is {}",
+                   typeid(TSmaccObjectType));
     stateCallbackConnections.push_back(connection);
   }
   else  // state life-time objects
@@ -356,7 +384,7 @@ void ISmaccStateMachine::notifyOnStateEntryStart(StateType *state)
 std:
   lock_guard<std::recursive_mutex> lock(m_mutex_);
 
-  ROS_DEBUG("[State Machne] Initializating a new state '%s' and updating current state. Getting state meta-information. number of orthogonals: %ld", demangleSymbol(typeid(StateType).name()).c_str(), this->orthogonals_.size());
+  SMACC_LOG_DEBUG("[State Machne] Initializating a new state '{}' and updating current state. Getting state meta-information. number of orthogonals: {}", typeid(StateType), this->orthogonals_.size());
 
   stateSeqCounter_++;
   currentState_ = state;
@@ -383,8 +411,7 @@ void ISmaccStateMachine::notifyOnStateEntryEnd(StateType *state)
 
   for (auto &sr : this->currentState_->getStateReactors())
   {
-    auto srname = smacc::demangleSymbol(typeid(*sr).name()).c_str();
-    ROS_INFO("state reactor onEntry: %s", srname);
+    SMACC_LOG_INFO("state reactor onEntry: {}", typeid(*sr));
     try
     {
       sr->onEntry();
@@ -392,7 +419,7 @@ void ISmaccStateMachine::notifyOnStateEntryEnd(StateType *state)
     catch (const std::exception &e)
     {
       ROS_ERROR("[State Reactor %s] Exception on Entry - continuing with next state reactor. Exception info: %s",
-                srname, e.what());
+                smacc::demangleSymbol(typeid(*sr).name()).c_str(), e.what());
     }
   }
 
@@ -415,7 +442,7 @@ void ISmaccStateMachine::notifyOnRuntimeConfigured(StateType *state)
 template <typename StateType>
 void ISmaccStateMachine::notifyOnStateExit(StateType *state)
 {
-  ROS_INFO_STREAM("Notification State Exit: leaving state" << state);
+  SMACC_LOG_INFO("Notification State Exit: leaving state {}", typeid(StateType));
   for (auto pair : this->orthogonals_)
   {
     auto &orthogonal = pair.second;
@@ -432,8 +459,7 @@ void ISmaccStateMachine::notifyOnStateExit(StateType *state)
 
   for (auto &sr : state->getStateReactors())
   {
-    auto srname = smacc::demangleSymbol(typeid(*sr).name()).c_str();
-    ROS_INFO("state reactor OnExit: %s", srname);
+    SMACC_LOG_INFO("state reactor OnExit: {}", typeid(*sr));
     try
     {
       sr->onExit();
@@ -441,13 +467,13 @@ void ISmaccStateMachine::notifyOnStateExit(StateType *state)
     catch (const std::exception &e)
     {
       ROS_ERROR("[State Reactor %s] Exception on OnExit - continuing with next state reactor. Exception info: %s",
-                srname, e.what());
+                smacc::demangleSymbol(typeid(*sr).name()).c_str(), e.what());
     }
   }
 
   for (auto &conn : this->stateCallbackConnections)
   {
-    ROS_WARN_STREAM("[StateMachine] Disconnecting scoped-lifetime SmaccSignal subscription");
+    SMACC_LOG_WARN("[StateMachine] Disconnecting scoped-lifetime SmaccSignal subscription");
     conn.disconnect();
   }
 
@@ -460,7 +486,7 @@ void ISmaccStateMachine::notifyOnStateExit(StateType *state)
 template <typename EventType>
 void ISmaccStateMachine::propagateEventToStateReactors(ISmaccState *st, EventType *ev)
 {
-  ROS_DEBUG("PROPAGATING EVENT [%s] TO LUs [%s]: ", demangleSymbol<EventType>().c_str(), st->getClassName().c_str());
+  SMACC_LOG_DEBUG("PROPAGATING EVENT [{}] TO LUs [{}]: ", typeid(EventType), typeid(*st));
   for (auto &sb : st->getStateReactors())
   {
     sb->notifyEvent(ev);
@@ -477,9 +503,18 @@ template <typename InitialStateType>
 void ISmaccStateMachine::buildStateMachineInfo()
 {
   this->stateMachineInfo_ = std::make_shared<SmaccStateMachineInfo>();
-  this->stateMachineInfo_->buildStateMachineInfo<InitialStateType>();
-  this->stateMachineInfo_->assembleSMStructureMessage(this);
-  this->checkStateMachineConsistence();
+  {
+    StartupProfiler::Scope scope("phase", "type walking");
+    this->stateMachineInfo_->buildStateMachineInfo<InitialStateType>();
+  }
+  {
+    StartupProfiler::Scope scope("phase", "assembleSMStructureMessage");
+    this->stateMachineInfo_->assembleSMStructureMessage(this);
+  }
+  {
+    StartupProfiler::Scope scope("phase", "checkStateMachineConsistence");
+    this->checkStateMachineConsistence();
+  }
 }
 
 unsigned long ISmaccStateMachine::getCurrentStateCounter() const
@@ -27,7 +27,8 @@ template <typename TEv>
 void StateReactor::setOutputEvent()
 {
     this->postEventFn = [this]() {
-        ROS_INFO_STREAM("[State Reactor Base] postingfn posting event: " << demangleSymbol<TEv>());
+        SMACC_TRACE_INSTANT_TYPE("reactor_trigger", typeid(TEv));
+        SMACC_LOG_INFO("[State Reactor Base] postingfn posting event: {}", typeid(TEv));
         auto *ev = new TEv();
         this->ownerState->getStateMachine().postEvent(ev);
     };
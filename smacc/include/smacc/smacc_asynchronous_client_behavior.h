@@ -0,0 +1,103 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+
+#pragma once
+#include <smacc/smacc_client_behavior.h>
+#include <smacc/smacc_timer_wheel.h>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace smacc
+{
+// Client behavior variant for behaviors that need to wait for slow operations (service calls,
+// timers, planning...) without blocking the state machine thread in onEntry.
+//
+// Work is described as a chain of continuations: blocking functions run in worker threads and the
+// continuations resume in the signal detector thread with the state machine locked (like update()).
+// Meanwhile the state machine keeps processing events. When the state is left, onExit cancels the
+// chain: the pending continuations are never executed.
+//
+// Example:
+//   void onEntry() override
+//   {
+//     this->runAsync([=] { plannerSwitcher->setDefaultPlanners(); },
+//                    [=] { this->delay(ros::Duration(1), [=] { client->sendGoal(goal); }); });
+//   }
+class SmaccAsyncClientBehavior : public SmaccClientBehavior,
+                                 public std::enable_shared_from_this<SmaccAsyncClientBehavior>
+{
+public:
+    SmaccAsyncClientBehavior();
+
+    virtual ~SmaccAsyncClientBehavior();
+
+    // returns true once the behavior has been exited. Long blocking functions executed with runAsync
+    // may check it to finish early
+    bool isCancelled() const;
+
+protected:
+    // Runs the blocking function in a worker thread. Its result is passed to the continuation.
+    template <typename TResult>
+    void runAsync(std::function<TResult()> function, std::function<void(const TResult &)> continuation);
+
+    void runAsync(std::function<void()> function, std::function<void()> continuation = nullptr);
+
+    // non blocking sleep, the continuation is executed after the given duration
+    void delay(ros::Duration duration, std::function<void()> continuation);
+
+    // Calls the ros service in a worker thread. The continuation receives the success flag and the response.
+    template <typename TService>
+    void callServiceAsync(ros::ServiceClient serviceClient, typename TService::Request request,
+                          std::function<void(bool, const typename TService::Response &)> continuation);
+
+private:
+    std::atomic<bool> cancelled_;
+
+    std::mutex timersMutex_;
+
+    std::list<TimerWheel::TimerId> timers_;
+
+    // enqueues the continuation in the signal detector thread. It is skipped if the behavior was cancelled
+    void resume(std::function<void()> continuation);
+
+    void cancelAsync();
+
+    friend class ISmaccOrthogonal;
+};
+
+template <typename TResult>
+void SmaccAsyncClientBehavior::runAsync(std::function<TResult()> function, std::function<void(const TResult &)> continuation)
+{
+    // the worker thread keeps the behavior alive until the function finishes even if the state was left
+    auto self = this->shared_from_this();
+    std::thread([self, function, continuation]() {
+        TResult result = function();
+        if (continuation)
+        {
+            self->resume([continuation, result]() { continuation(result); });
+        }
+    })
+        .detach();
+}
+
+template <typename TService>
+void SmaccAsyncClientBehavior::callServiceAsync(ros::ServiceClient serviceClient, typename TService::Request request,
+                                                std::function<void(bool, const typename TService::Response &)> continuation)
+{
+    typedef std::pair<bool, typename TService::Response> TResult;
+    this->runAsync<TResult>(
+        [serviceClient, request]() mutable {
+            typename TService::Response response;
+            bool success = serviceClient.call(request, response);
+            return TResult(success, response);
+        },
+        [continuation](const TResult &result) { continuation(result.first, result.second); });
+}
+} // namespace smacc
@@ -0,0 +1,46 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <ros/callback_queue.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace smacc
+{
+// Dedicated callback queue of a client, served by its own threads, so the callbacks of a slow client
+// (ie: a lidar subscriber) do not delay the callbacks of the other clients (ie: move_base results).
+//
+// It is configured per client type with the ros parameters:
+//   ~callback_queues/<ClientShortName>/threads  amount of threads serving the queue (default 1)
+//   ~callback_queues/<ClientShortName>/cpus     optional list of cpus where those threads are pinned
+// Clients without configuration keep using the global callback queue.
+class ClientCallbackQueue
+{
+public:
+    // returns nullptr if the client has no dedicated queue configured
+    static std::shared_ptr<ClientCallbackQueue> create(std::string clientName);
+
+    ClientCallbackQueue(std::string name, int threads, std::vector<int> cpus);
+
+    ~ClientCallbackQueue();
+
+    inline ros::CallbackQueue *getQueue() { return &queue_; }
+
+    inline const std::string &getName() const { return name_; }
+
+private:
+    std::string name_;
+    ros::CallbackQueue queue_;
+    std::atomic<bool> stop_;
+    std::vector<std::thread> threads_;
+
+    void spin();
+};
+} // namespace smacc
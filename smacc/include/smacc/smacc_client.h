@@ -7,7 +7,9 @@
 
 #include <smacc/common.h>
 #include <smacc/component.h>
+#include <smacc/smacc_callback_queue.h>
 #include <typeinfo>
+#include <vector>
 
 namespace smacc
 {
@@ -41,9 +43,34 @@ public:
 
     virtual void initialize();
 
+    // ros connections (action server, service, topic publishers...) waited at startup by the ConnectionWarmup
+    // before the state machine enters its initial state
+    virtual bool requiresConnection();
+
+    virtual bool isConnected();
+
+    // ordering constraint of the parallel client initialization (see ClientInitializer): this client is
+    // initialized after the client of the given type
+    template <typename TClient>
+    void initializeAfter()
+    {
+        initializeAfter_.push_back(&typeid(TClient));
+    }
+
+    inline const std::vector<const std::type_info *> &getInitializeAfter() const { return initializeAfter_; }
+
+    // the client is initialized when initialize() is called, even if the parallel client initialization is enabled
+    inline void setSerialInitialization(bool value) { serialInitialization_ = value; }
+
+    inline bool isSerialInitialization() const { return serialInitialization_; }
+
     // Returns a custom identifier defined by the specific plugin implementation
     virtual std::string getName() const;
 
+    // short name of the client type declared in the orthogonal (TClient). typeid(*this) is not used because
+    // the most derived type of the client object is its ClientHandler
+    inline const std::string &getShortTypeName() const { return shortTypeName_; }
+
     template <typename EventType>
     void postEvent(const EventType &ev);
 
@@ -69,6 +96,12 @@ public:
     template <typename SmaccClientType>
     void requiresClient(SmaccClientType *&storage);
 
+    // callback queue where the client registers its ros callbacks (subscribers, action clients...): its dedicated
+    // queue if it is configured (see ClientCallbackQueue) or the global callback queue otherwise
+    ros::CallbackQueueInterface *getCallbackQueue();
+
+    inline bool hasDedicatedCallbackQueue() const { return callbackQueue_ != nullptr; }
+
     void getComponents(std::vector<std::shared_ptr<ISmaccComponent>> &components)
     {
         for (auto &ce : components_)
@@ -92,11 +125,21 @@ protected:
 
     void setOrthogonal(ISmaccOrthogonal *orthogonal);
 
+    void setCallbackQueue(std::shared_ptr<ClientCallbackQueue> callbackQueue);
+
 private:
     // A reference to the state machine object that owns this resource
     ISmaccStateMachine *stateMachine_;
     ISmaccOrthogonal *orthogonal_;
 
+    // the subscribers of the derived clients are destroyed before this queue stops its threads
+    std::shared_ptr<ClientCallbackQueue> callbackQueue_;
+
+    std::vector<const std::type_info *> initializeAfter_;
+    bool serialInitialization_;
+
+    std::string shortTypeName_;
+
     friend class ISmaccOrthogonal;
 };
 } // namespace smacc
\ No newline at end of file
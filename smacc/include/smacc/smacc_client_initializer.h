@@ -0,0 +1,65 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+namespace smacc
+{
+class ISmaccClient;
+
+// Parallel initialization of the clients at startup. While the orthogonals are created (onInitializing), the
+// initialize() calls of their clients are deferred. Then all the deferred clients are initialized on a pool of
+// threads, so the startup time is bounded by the slowest client instead of the sum of all of them.
+//
+// The order between clients is declared with ISmaccClient::initializeAfter<TClient>(). Clients that must
+// be initialized at the point initialize() is called (ie: the rest of onInitialize uses them) declare
+// ISmaccClient::setSerialInitialization(true).
+//
+// It is disabled by default. It is enabled with the ros parameter:
+//   ~parallel_client_initialization/threads  amount of threads of the pool (default 0: serial initialization)
+class ClientInitializer
+{
+public:
+    ClientInitializer();
+
+    // starts deferring the client initialization if it is enabled
+    void begin();
+
+    // initializes the deferred clients and stops deferring. If some initialization throws,
+    // the first exception is rethrown once all the others are done
+    void run();
+
+    // returns false if the client must be initialized right now
+    bool defer(ISmaccClient *client, const std::type_info &clientType, std::function<void()> initialize);
+
+private:
+    struct DeferredClient
+    {
+        ISmaccClient *client;
+        const std::type_info *clientType;
+        std::function<void()> initialize;
+        std::vector<int> dependencies;
+        bool started;
+        bool done;
+    };
+
+    std::mutex mutex_;
+    bool deferring_;
+    int threads_;
+    std::vector<DeferredClient> deferred_;
+
+    void resolveDependencies();
+
+    // returns the index of a client ready to initialize, -1 if there is none
+    int nextReadyClient();
+
+    bool allDone();
+};
+} // namespace smacc
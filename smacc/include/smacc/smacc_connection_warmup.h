@@ -0,0 +1,39 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <ros/ros.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace smacc
+{
+class ISmaccClient;
+
+// Startup phase that waits for the ros connections of the clients (action servers, services, topic publishers)
+// before the state machine enters its initial state. All the clients are waited in parallel, with a global
+// deadline, and the connect latency of every client is reported.
+//
+// It is configured with the ros parameters:
+//   ~connection_warmup/timeout  global deadline in seconds (default 5.0). Zero disables the warm-up
+//   ~connection_warmup/ignore   optional list of client type short names that are not waited (ie: ClMoveBaseZ)
+class ConnectionWarmup
+{
+public:
+    struct ClientConnection
+    {
+        std::string clientName;
+        bool connected;
+        ros::WallDuration latency;
+    };
+
+    // returns the connection status of the clients that require a connection
+    static std::vector<ClientConnection> waitForConnections(const std::vector<std::shared_ptr<ISmaccClient>> &clients);
+
+    static void printReport(const std::vector<ClientConnection> &report);
+};
+} // namespace smacc
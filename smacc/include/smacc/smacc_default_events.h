@@ -123,6 +123,160 @@ struct EvActionRejected : sc::event<EvActionRejected<TSource, TObjectTag>>
   }
 };
 
+//--------------------------------
+// events of the multi goal action clients, the goal id is the one returned by sendGoal
+template <typename TSource, typename TObjectTag>
+struct EvGoalSucceeded : sc::event<EvGoalSucceeded<TSource, TObjectTag>>
+{
+  unsigned long goalId;
+  typename TSource::Result resultMessage;
+
+  static std::string getEventLabel()
+  {
+    std::string label;
+    EventLabel<TSource>(label);
+    return label;
+  }
+
+  static std::string getDefaultTransitionTag()
+  {
+    return demangledTypeName<SUCCESS>();
+  }
+
+  static std::string getDefaultTransitionType()
+  {
+    return demangledTypeName<SUCCESS>();
+  }
+};
+
+template <typename TSource, typename TObjectTag>
+struct EvGoalAborted : sc::event<EvGoalAborted<TSource, TObjectTag>>
+{
+  unsigned long goalId;
+  typename TSource::Result resultMessage;
+
+  static std::string getEventLabel()
+  {
+    std::string label;
+    EventLabel<TSource>(label);
+    return label;
+  }
+
+  static std::string getDefaultTransitionTag()
+  {
+    return demangledTypeName<ABORT>();
+  }
+
+  static std::string getDefaultTransitionType()
+  {
+    return demangledTypeName<ABORT>();
+  }
+};
+
+template <typename TSource, typename TObjectTag>
+struct EvGoalPreempted : sc::event<EvGoalPreempted<TSource, TObjectTag>>
+{
+  unsigned long goalId;
+  typename TSource::Result resultMessage;
+
+  static std::string getEventLabel()
+  {
+    std::string label;
+    EventLabel<TSource>(label);
+    return label;
+  }
+
+  static std::string getDefaultTransitionTag()
+  {
+    return demangledTypeName<PREEMPT>();
+  }
+
+  static std::string getDefaultTransitionType()
+  {
+    return demangledTypeName<PREEMPT>();
+  }
+};
+
+template <typename TSource, typename TObjectTag>
+struct EvGoalRejected : sc::event<EvGoalRejected<TSource, TObjectTag>>
+{
+  unsigned long goalId;
+  typename TSource::Result resultMessage;
+
+  static std::string getEventLabel()
+  {
+    std::string label;
+    EventLabel<TSource>(label);
+    return label;
+  }
+
+  static std::string getDefaultTransitionTag()
+  {
+    return demangledTypeName<REJECT>();
+  }
+
+  static std::string getDefaultTransitionType()
+  {
+    return demangledTypeName<REJECT>();
+  }
+};
+
+template <typename TSource, typename TObjectTag>
+struct EvGoalFeedback : sc::event<EvGoalFeedback<TSource, TObjectTag>>
+{
+  unsigned long goalId;
+  typename TSource::Feedback feedbackMessage;
+};
+
+//--------------------------------
+template <typename TSource, typename TObjectTag>
+struct EvServiceResponse : sc::event<EvServiceResponse<TSource, TObjectTag>>
+{
+  // id returned by callAsync
+  unsigned long callId;
+  typename TSource::TResponse response;
+
+  static std::string getEventLabel()
+  {
+    auto typeinfo = TypeInfo::getTypeInfoFromType<typename TSource::TService>();
+    return typeinfo->getNonTemplatedTypeName();
+  }
+
+  static std::string getDefaultTransitionTag()
+  {
+    return demangledTypeName<SUCCESS>();
+  }
+
+  static std::string getDefaultTransitionType()
+  {
+    return demangledTypeName<SUCCESS>();
+  }
+};
+
+template <typename TSource, typename TObjectTag>
+struct EvServiceFailure : sc::event<EvServiceFailure<TSource, TObjectTag>>
+{
+  // id returned by callAsync
+  unsigned long callId;
+  std::string error;
+
+  static std::string getEventLabel()
+  {
+    auto typeinfo = TypeInfo::getTypeInfoFromType<typename TSource::TService>();
+    return typeinfo->getNonTemplatedTypeName();
+  }
+
+  static std::string getDefaultTransitionTag()
+  {
+    return demangledTypeName<ABORT>();
+  }
+
+  static std::string getDefaultTransitionType()
+  {
+    return demangledTypeName<ABORT>();
+  }
+};
+
 template <typename StateType>
 struct EvSequenceFinished : sc::event<EvSequenceFinished<StateType>>
 {
@@ -0,0 +1,277 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <ros/console.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+// SMACC internal logging facade.
+//
+// A log call does not format anything: it stores a pointer to a static call-site descriptor (the
+// format id) plus the raw arguments into a lock-free ring. A background thread formats the records
+// and forwards them to rosconsole. Type arguments (typeid(T)) are demangled in the background thread.
+// The rosconsole logger level is checked at the call site: disabled messages are not enqueued.
+//
+// Placeholders in the format string are written as "{}". Example:
+//     SMACC_LOG_INFO("[{}] state created, orthogonals: {}", typeid(MostDerived), orthogonals.size());
+//
+// Log calls below SMACC_LOG_MIN_LEVEL are removed at compile time. By default none is removed, so the
+// debug messages can still be enabled at runtime through the rosconsole logger levels.
+//
+// shutdownLog() writes the pending records and stops the background thread, smacc::run calls it when the
+// node finishes. Later log calls are formatted and written by the calling thread.
+
+#define SMACC_LOG_LEVEL_DEBUG 0
+#define SMACC_LOG_LEVEL_INFO 1
+#define SMACC_LOG_LEVEL_WARN 2
+#define SMACC_LOG_LEVEL_ERROR 3
+#define SMACC_LOG_LEVEL_NONE 4
+
+#ifndef SMACC_LOG_MIN_LEVEL
+#define SMACC_LOG_MIN_LEVEL SMACC_LOG_LEVEL_DEBUG
+#endif
+
+namespace smacc
+{
+namespace logging
+{
+// static descriptor of a log call site. Its address identifies the message format.
+struct LogSite
+{
+    int level;
+    const char *format;
+    const char *file;
+    int line;
+    const char *function;
+
+    // rosconsole logger of the call site
+    ros::console::LogLocation *location;
+};
+
+inline ros::console::Level toRosconsoleLevel(int level)
+{
+    switch (level)
+    {
+    case SMACC_LOG_LEVEL_DEBUG:
+        return ros::console::levels::Debug;
+    case SMACC_LOG_LEVEL_INFO:
+        return ros::console::levels::Info;
+    case SMACC_LOG_LEVEL_WARN:
+        return ros::console::levels::Warn;
+    default:
+        return ros::console::levels::Error;
+    }
+}
+
+enum class LogArgType : uint8_t
+{
+    INT,
+    UINT,
+    DOUBLE,
+    BOOL,
+    STRING,
+    TYPE
+};
+
+const size_t LOG_RECORD_PAYLOAD_SIZE = 232;
+
+struct LogRecord
+{
+    const LogSite *site;
+    uint16_t size;
+    bool truncated;
+    char payload[LOG_RECORD_PAYLOAD_SIZE];
+};
+
+// serializes the raw log arguments into the payload of a log record
+class LogArgsWriter
+{
+public:
+    inline LogArgsWriter(LogRecord &record)
+        : record_(record)
+    {
+        record_.size = 0;
+        record_.truncated = false;
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type write(T value)
+    {
+        int64_t v = value;
+        writeRaw(LogArgType::INT, &v, sizeof(v));
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value && !std::is_same<T, bool>::value>::type write(T value)
+    {
+        uint64_t v = value;
+        writeRaw(LogArgType::UINT, &v, sizeof(v));
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_floating_point<T>::value>::type write(T value)
+    {
+        double v = value;
+        writeRaw(LogArgType::DOUBLE, &v, sizeof(v));
+    }
+
+    inline void write(bool value)
+    {
+        writeRaw(LogArgType::BOOL, &value, sizeof(value));
+    }
+
+    inline void write(const std::type_info &tinfo)
+    {
+        // only the pointer to the (static) mangled name is stored
+        const char *name = tinfo.name();
+        writeRaw(LogArgType::TYPE, &name, sizeof(name));
+    }
+
+    inline void write(const std::string &str)
+    {
+        writeString(str.c_str(), str.size());
+    }
+
+    inline void write(const char *str)
+    {
+        writeString(str, strlen(str));
+    }
+
+    inline void writeAll()
+    {
+    }
+
+    template <typename T, typename... TArgs>
+    inline void writeAll(const T &first, const TArgs &... rest)
+    {
+        write(first);
+        writeAll(rest...);
+    }
+
+private:
+    LogRecord &record_;
+
+    inline void writeRaw(LogArgType type, const void *data, size_t size)
+    {
+        if (record_.size + 1 + size > LOG_RECORD_PAYLOAD_SIZE)
+        {
+            record_.truncated = true;
+            return;
+        }
+
+        record_.payload[record_.size] = (char)type;
+        memcpy(record_.payload + record_.size + 1, data, size);
+        record_.size += 1 + size;
+    }
+
+    inline void writeString(const char *str, size_t length)
+    {
+        if (record_.size + 1 + sizeof(uint16_t) > LOG_RECORD_PAYLOAD_SIZE)
+        {
+            record_.truncated = true;
+            return;
+        }
+
+        size_t available = LOG_RECORD_PAYLOAD_SIZE - record_.size - 1 - sizeof(uint16_t);
+        if (length > available)
+        {
+            length = available;
+            record_.truncated = true;
+        }
+
+        uint16_t len = length;
+        record_.payload[record_.size] = (char)LogArgType::STRING;
+        memcpy(record_.payload + record_.size + 1, &len, sizeof(len));
+        memcpy(record_.payload + record_.size + 1 + sizeof(len), str, length);
+        record_.size += 1 + sizeof(len) + length;
+    }
+};
+
+// Reserves a slot in the lock-free log ring. Returns nullptr if the ring is full (the message is dropped)
+LogRecord *acquireLogRecord(const LogSite *site);
+
+// Makes the record visible for the background formatting thread (or writes it, after shutdownLog)
+void commitLogRecord(LogRecord *record);
+
+// Amount of messages dropped because the ring was full
+unsigned long getDroppedLogCount();
+
+// Blocks until all the pending records have been formatted and written
+void flushLog();
+
+// Writes the pending records and stops the background thread. Called at the node shutdown, before the static
+// destruction (rosconsole must still be alive)
+void shutdownLog();
+
+template <typename... TArgs>
+inline void log(const LogSite *site, const TArgs &... args)
+{
+    LogRecord *record = acquireLogRecord(site);
+    if (record != nullptr)
+    {
+        LogArgsWriter writer(*record);
+        writer.writeAll(args...);
+        commitLogRecord(record);
+    }
+}
+
+// formats a record replacing the "{}" placeholders with the stored arguments
+std::string formatLogRecord(const LogRecord &record);
+} // namespace logging
+} // namespace smacc
+
+#define SMACC_LOG_IMPL(level, format, ...)                                                                      \
+    do                                                                                                          \
+    {                                                                                                           \
+        ROSCONSOLE_DEFINE_LOCATION(true, smacc::logging::toRosconsoleLevel(level), ROSCONSOLE_DEFAULT_NAME);    \
+        if (ROS_UNLIKELY(__rosconsole_define_location__enabled))                                                \
+        {                                                                                                       \
+            static const smacc::logging::LogSite smacc_log_site_ = {level, format, __FILE__, __LINE__,          \
+                                                                    __ROSCONSOLE_FUNCTION__,                    \
+                                                                    &__rosconsole_define_location__loc};        \
+            smacc::logging::log(&smacc_log_site_, ##__VA_ARGS__);                                               \
+        }                                                                                                       \
+    } while (0)
+
+#if SMACC_LOG_MIN_LEVEL <= SMACC_LOG_LEVEL_DEBUG
+#define SMACC_LOG_DEBUG(format, ...) SMACC_LOG_IMPL(SMACC_LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define SMACC_LOG_DEBUG(format, ...) \
+    do                               \
+    {                                \
+    } while (0)
+#endif
+
+#if SMACC_LOG_MIN_LEVEL <= SMACC_LOG_LEVEL_INFO
+#define SMACC_LOG_INFO(format, ...) SMACC_LOG_IMPL(SMACC_LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define SMACC_LOG_INFO(format, ...) \
+    do                              \
+    {                               \
+    } while (0)
+#endif
+
+#if SMACC_LOG_MIN_LEVEL <= SMACC_LOG_LEVEL_WARN
+#define SMACC_LOG_WARN(format, ...) SMACC_LOG_IMPL(SMACC_LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#else
+#define SMACC_LOG_WARN(format, ...) \
+    do                              \
+    {                               \
+    } while (0)
+#endif
+
+#if SMACC_LOG_MIN_LEVEL <= SMACC_LOG_LEVEL_ERROR
+#define SMACC_LOG_ERROR(format, ...) SMACC_LOG_IMPL(SMACC_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define SMACC_LOG_ERROR(format, ...) \
+    do                               \
+    {                                \
+    } while (0)
+#endif
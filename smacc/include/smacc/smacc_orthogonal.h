@@ -50,7 +50,8 @@ public:
 protected:
     virtual void onInitialize();
 
-    void assignClientToOrthogonal(smacc::ISmaccClient* client);
+    // the client type (not the ClientHandler) names its callback queue configuration
+    void assignClientToOrthogonal(smacc::ISmaccClient* client, const std::type_info &clientType);
 
     std::vector<std::shared_ptr<smacc::ISmaccClient>> clients_;
 
@@ -0,0 +1,125 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <smacc/smacc_timer_wheel.h>
+#include <ros/ros.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace smacc
+{
+// Executes ros service calls in a pool of worker threads, so the state machine never blocks on a service.
+// Several calls may be outstanding at the same time (as many running as workers, the rest queued).
+// Every worker keeps a persistent connection per service, which is recreated after a failed call.
+//
+// The done callback of a call is called exactly once: with the response, or with an error if the call
+// failed or its timeout expired (the late response is discarded). It is called from a worker thread or
+// from the timer wheel thread, and never after the pool is destroyed.
+class ServiceCallPool
+{
+public:
+    typedef unsigned long CallId;
+
+    ServiceCallPool(int workers = 2);
+
+    // discards the queued calls and waits for the done callbacks in progress (except the one of the calling
+    // thread, if the pool is destroyed from a done callback). It does not wait for the calls blocked in the
+    // workers, the workers finish on their own once those calls return
+    ~ServiceCallPool();
+
+    // timeout zero means no timeout. The timeout includes the time the call is queued
+    template <typename TService>
+    CallId call(std::string serviceName, const typename TService::Request &request, ros::Duration timeout,
+                std::function<void(CallId, bool, const typename TService::Response &, const std::string &)> onDone);
+
+    int getWorkers() const { return workers_; }
+
+private:
+    typedef std::map<std::string, ros::ServiceClient> Connections;
+
+    // shared with the worker threads and timers, which may outlive the pool
+    struct State
+    {
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::deque<std::function<void(Connections &)>> jobs;
+        bool stop = false;
+
+        // the done callbacks are called without this mutex (they post events, which takes the state machine
+        // lock). The threads running one are registered, the destructor waits for them
+        std::mutex doneMutex;
+        std::condition_variable doneCondition;
+        bool alive = true;
+        std::map<CallId, TimerWheel::TimerId> pending;
+        std::vector<std::thread::id> runningCallbacks;
+        CallId nextCallId = 1;
+    };
+
+    int workers_;
+    std::shared_ptr<State> state_;
+
+    // the workers are started with the first call
+    bool started_;
+
+    static void workerLoop(std::shared_ptr<State> state);
+
+    static bool isPending(State &state, CallId callId);
+
+    // calls done if the call was still pending
+    static void complete(State &state, CallId callId, std::function<void()> done);
+
+    // registers a pending call and its timeout
+    CallId registerCall(ros::Duration timeout, std::function<void(CallId)> onTimeout);
+
+    void enqueue(std::function<void(Connections &)> job);
+};
+
+template <typename TService>
+ServiceCallPool::CallId ServiceCallPool::call(std::string serviceName, const typename TService::Request &request, ros::Duration timeout,
+                                              std::function<void(CallId, bool, const typename TService::Response &, const std::string &)> onDone)
+{
+    auto state = state_;
+
+    auto onTimeout = [state, onDone, serviceName](CallId id) {
+        complete(*state, id, [&]() { onDone(id, false, typename TService::Response(), "service call timeout: " + serviceName); });
+    };
+
+    CallId callId = this->registerCall(timeout, onTimeout);
+
+    this->enqueue([state, callId, serviceName, request, onDone](Connections &connections) {
+        if (!isPending(*state, callId))
+            return; // timed out while it was queued
+
+        auto &connection = connections[serviceName];
+        if (!connection.isValid())
+        {
+            ros::NodeHandle nh;
+            connection = nh.serviceClient<TService>(serviceName, true /*persistent*/);
+        }
+
+        TService srv;
+        srv.request = request;
+        bool success = connection.call(srv);
+        if (!success)
+        {
+            // the persistent connection is recreated in the next call
+            connection.shutdown();
+        }
+
+        complete(*state, callId, [&]() { onDone(callId, success, srv.response, success ? "" : "service call failed: " + serviceName); });
+    });
+
+    return callId;
+}
+} // namespace smacc
@@ -8,6 +8,8 @@
 #include <boost/thread.hpp>
 #include <smacc/common.h>
 #include <atomic>
+#include <functional>
+#include <mutex>
 
 namespace smacc
 {
@@ -39,6 +41,10 @@ public:
         this->scheduler_->queue_event(processorHandle_, weakPtrEvent);
     }
 
+    // enqueues a function that will be executed in the polling thread with the state machine locked
+    // (thread safe). Used to resume asynchronous client behaviors
+    void postContinuation(std::function<void()> continuation);
+
 private:
     ISmaccStateMachine *smaccStateMachine_;
 
@@ -51,6 +57,20 @@ private:
     void findUpdatableClients();
     void findUpdatableStateElements(ISmaccState* currentState);
 
+    // reads the update budget of the updatable object from the ros parameter ~update_budgets/<ShortTypeName>
+    void configureUpdateBudget(ISmaccUpdatable *updatable);
+
+    void executeUpdatable(ISmaccUpdatable *updatable);
+
+    void executeContinuations();
+
+    std::mutex continuationsMutex_;
+
+    std::vector<std::function<void()>> continuations_;
+
+    // publishes the execution time statistics of the updatable objects on /diagnostics
+    void publishUpdateDiagnostics();
+
     // Loop frequency of the signal detector (to check answers from actionservers)
     double loop_rate_hz;
 
@@ -60,6 +80,12 @@ private:
 
     ros::Publisher statusPub_;
 
+    ros::Publisher diagnosticsPub_;
+
+    ros::Time lastDiagnosticsPublish_;
+
+    bool pendingOverrunDiagnostics_;
+
     // ---- boost statechart related ----
 
     SmaccFifoScheduler *scheduler_;
@@ -97,6 +123,9 @@ void run()
 
     // use the  main thread for the signal detector component (waiting actionclient requests)
     signalDetector.pollingLoop();
+
+    // the pending log messages are written while rosconsole is alive, later ones are written synchronously
+    smacc::logging::shutdownLog();
 }
 
 } // namespace smacc
\ No newline at end of file
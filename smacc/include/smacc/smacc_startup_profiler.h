@@ -0,0 +1,67 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <smacc_msgs/SmaccStartupReport.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace smacc
+{
+// Measures the steps of the state machine startup (initiate_impl): its phases, the creation of the orthogonals,
+// clients and components and the initialize() of every client. The report is published as a
+// smacc_msgs/SmaccStartupReport message and printed as a log table.
+//
+// Steps are only recorded while the profiler is running, so the clients and components created later
+// (ie: by states) do not pay for it. The heap growth of a step is measured with the allocator statistics
+// (glibc only), so it includes the allocations of other threads running at the same time.
+class StartupProfiler
+{
+public:
+    static StartupProfiler &getInstance();
+
+    // discards the previous report and starts recording
+    void start();
+
+    void stop();
+
+    inline bool isRunning() const { return running_; }
+
+    smacc_msgs::SmaccStartupReport getReport();
+
+    void printReport();
+
+    // Records a step for the lifetime of the scope. Nested scopes of the same thread are reported as substeps
+    class Scope
+    {
+    public:
+        Scope(const char *category, const std::string &name);
+        ~Scope();
+
+    private:
+        int index_;
+        uint64_t startNs_;
+        int64_t startHeap_;
+    };
+
+private:
+    StartupProfiler();
+
+    std::mutex mutex_;
+    std::atomic<bool> running_;
+    uint64_t startNs_;
+    uint64_t stopNs_;
+    std::vector<smacc_msgs::SmaccStartupPhase> phases_;
+
+    // returns the index of the new step
+    int beginStep(const char *category, const std::string &name, int depth);
+
+    void endStep(int index, uint64_t durationNs, int64_t heapBytes);
+};
+} // namespace smacc
@@ -54,7 +54,7 @@ public:
 
     static_assert(!std::is_same<MostDerived, Context>::value, "The context must be a different state or state machine than the current state");
 
-    ROS_WARN("[%s] creating ", STATE_NAME);
+    SMACC_LOG_WARN("[{}] creating ", typeid(MostDerived));
     this->set_context(ctx.pContext_);
 
     this->stateInfo_ = getStateInfo();
@@ -65,11 +65,11 @@ public:
     finishStateThrown = false;
 
     this->contextNh = optionalNodeHandle(ctx.pContext_);
-    ROS_DEBUG("[%s] Ros node handle namespace for this state: %s", STATE_NAME, contextNh.getNamespace().c_str());
+    SMACC_LOG_DEBUG("[{}] Ros node handle namespace for this state: {}", typeid(MostDerived), contextNh.getNamespace());
     if (contextNh.getNamespace() == "/")
     {
       auto nhname = smacc::utils::cleanShortTypeName(typeid(Context));
-      ROS_INFO("[%s] Creating ros NodeHandle for this state: %s", STATE_NAME, nhname.c_str());
+      SMACC_LOG_INFO("[{}] Creating ros NodeHandle for this state: {}", typeid(MostDerived), nhname);
       contextNh = ros::NodeHandle(nhname);
     }
   }
@@ -113,18 +113,18 @@ public:
   // this function is called by boot statechart before the destructor call
   void exit()
   {
+    SMACC_TRACE_SCOPE_TYPE("state_exit", typeid(MostDerived));
     try
     {
       this->requestLockStateMachine("state exit");
-      auto fullname = demangleSymbol(typeid(MostDerived).name());
-      ROS_WARN_STREAM("exiting state: " << fullname);
+      SMACC_LOG_WARN("exiting state: {}", typeid(MostDerived));
       //this->setParam("destroyed", true);
 
       // first process orthogonals onexits
       this->getStateMachine().notifyOnStateExit(static_cast<MostDerived *>(this));
 
       // then call exit state
-      ROS_WARN_STREAM("state exit: " << fullname);
+      SMACC_LOG_WARN("state exit: {}", typeid(MostDerived));
       static_cast<MostDerived *>(this)->onExit();
     }
     catch (...)
@@ -240,7 +240,7 @@ public:
     {
       this->postEvent<EvLoopEnd<MostDerived>>();
     }
-    ROS_INFO("[]%s POST THROW CONDITION", STATE_NAME);
+    SMACC_LOG_INFO("[{}] POST THROW CONDITION", typeid(MostDerived));
   }
 
   void throwSequenceFinishedEvent()
@@ -284,7 +284,7 @@ public:
     auto state = new MostDerived(SmaccState<MostDerived, Context, InnerInitial, historyMode>::my_context(pContext));
     const inner_context_ptr_type pInnerContext(state);
 
-    ROS_INFO("[%s] State object created. Initializating...", STATE_NAME);
+    SMACC_LOG_INFO("[{}] State object created. Initializating...", typeid(MostDerived));
     state->entryStateInternal();
 
     outermostContextBase.add(pInnerContext);
@@ -294,25 +294,26 @@ public:
 private:
   void entryStateInternal()
   {
+    SMACC_TRACE_SCOPE_TYPE("state_entry", typeid(MostDerived));
     this->getStateMachine().notifyOnStateEntryStart(static_cast<MostDerived *>(this));
 
     // TODO: make this static to build the parameter tree at startup
     this->nh = ros::NodeHandle(contextNh.getNamespace() + std::string("/") + smacc::utils::cleanShortTypeName(typeid(MostDerived)).c_str());
 
-    ROS_DEBUG("[%s] nodehandle namespace: %s", STATE_NAME, nh.getNamespace().c_str());
+    SMACC_LOG_DEBUG("[{}] nodehandle namespace: {}", typeid(MostDerived), nh.getNamespace());
 
     this->setParam("created", true);
 
     // before dynamic runtimeConfigure, we execute the staticConfigure behavior configurations
     {
-      ROS_INFO("[%s] -- STATIC STATE DESCRIPTION --", STATE_NAME);
+      SMACC_LOG_INFO("[{}] -- STATIC STATE DESCRIPTION --", typeid(MostDerived));
 
       for (const auto &stateReactorsVector : SmaccStateInfo::staticBehaviorInfo)
       {
-        ROS_DEBUG("[%s] state info: %s", STATE_NAME,  demangleSymbol(stateReactorsVector.first->name()).c_str());
+        SMACC_LOG_DEBUG("[{}] state info: {}", typeid(MostDerived), *stateReactorsVector.first);
         for (auto &bhinfo : stateReactorsVector.second)
         {
-          ROS_DEBUG("[%s] client behavior: %s", STATE_NAME,  demangleSymbol(bhinfo.behaviorType->name()).c_str());
+          SMACC_LOG_DEBUG("[{}] client behavior: {}", typeid(MostDerived), *bhinfo.behaviorType);
         }
       }
 
@@ -322,20 +323,20 @@ private:
 
       for (auto &bhinfo : staticDefinedBehaviors)
       {
-        ROS_INFO("[%s] Creating static client behavior: %s", STATE_NAME, demangleSymbol(bhinfo.behaviorType->name()).c_str());
+        SMACC_LOG_INFO("[{}] Creating static client behavior: {}", typeid(MostDerived), *bhinfo.behaviorType);
         bhinfo.factoryFunction(this);
       }
 
       for (auto &sr : staticDefinedStateReactors)
       {
-        ROS_INFO("[%s] Creating static state reactor: %s", STATE_NAME,  demangleSymbol(sr->stateReactorType->name()).c_str());
+        SMACC_LOG_INFO("[{}] Creating static state reactor: {}", typeid(MostDerived), *sr->stateReactorType);
         sr->factoryFunction(this);
       }
 
-      ROS_INFO("[%s] ---- END STATIC DESCRIPTION", STATE_NAME);
+      SMACC_LOG_INFO("[{}] ---- END STATIC DESCRIPTION", typeid(MostDerived));
     }
 
-    ROS_INFO("[%s] State runtime configuration", STATE_NAME);
+    SMACC_LOG_INFO("[{}] State runtime configuration", typeid(MostDerived));
 
     // first we runtime configure the state, where we create client behaviors
     static_cast<MostDerived *>(this)->runtimeConfigure();
@@ -343,11 +344,11 @@ private:
     // second the orthogonals are internally configured
     this->getStateMachine().notifyOnRuntimeConfigured(static_cast<MostDerived *>(this));
 
-    ROS_INFO("[%s] State OnEntry", STATE_NAME);
+    SMACC_LOG_INFO("[{}] State OnEntry", typeid(MostDerived));
 
     // finally we go to the derived state onEntry Function
     static_cast<MostDerived *>(this)->onEntry();
-    ROS_INFO("[%s] State OnEntry code finished", STATE_NAME);
+    SMACC_LOG_INFO("[{}] State OnEntry code finished", typeid(MostDerived));
 
     // here orthogonals and client behaviors are entered OnEntry
     this->getStateMachine().notifyOnStateEntryEnd(static_cast<MostDerived *>(this));
@@ -13,12 +13,15 @@
 #include <smacc/introspection/introspection.h>
 #include <smacc/introspection/smacc_state_machine_info.h>
 #include <smacc/smacc_updatable.h>
+#include <smacc/smacc_timer_wheel.h>
+#include <smacc/smacc_client_initializer.h>
 #include <smacc/smacc_signal.h>
 
 #include <smacc_msgs/SmaccStateMachine.h>
 #include <smacc_msgs/SmaccTransitionLogEntry.h>
 #include <smacc_msgs/SmaccStatus.h>
 #include <smacc_msgs/SmaccGetTransitionHistory.h>
+#include <smacc_msgs/SmaccDumpTrace.h>
 
 #include <smacc/smacc_state.h>
 #include <smacc/smacc_state_reactor.h>
@@ -49,6 +52,8 @@ public:
 
     const std::map<std::string, std::shared_ptr<smacc::ISmaccOrthogonal>> &getOrthogonals() const;
 
+    inline ClientInitializer &getClientInitializer() { return clientInitializer_; }
+
     template <typename SmaccComponentType>
     void requiresComponent(SmaccComponentType *&storage);
 
@@ -58,6 +63,17 @@ public:
     template <typename EventType>
     void postEvent();
 
+    // posts the event once the delay expires (thread safe). It is scheduled in the shared timer wheel,
+    // the pending delayed events are discarded when the state machine is destroyed
+    template <typename EventType>
+    void postEvent(EventType *ev, ros::Duration delay);
+
+    template <typename EventType>
+    void postEvent(ros::Duration delay);
+
+    // executes the function in the signal detector thread with the state machine locked (thread safe)
+    void postContinuation(std::function<void()> continuation);
+
     void getTransitionLogHistory();
 
     template <typename T>
@@ -84,6 +100,8 @@ public:
 
     bool getTransitionLogHistory(smacc_msgs::SmaccGetTransitionHistory::Request &req, smacc_msgs::SmaccGetTransitionHistory::Response &res);
 
+    bool dumpTrace(smacc_msgs::SmaccDumpTrace::Request &req, smacc_msgs::SmaccDumpTrace::Response &res);
+
     template <typename TSmaccSignal, typename TMemberFunctionPrototype, typename TSmaccObjectType>
     boost::signals2::connection createSignalConnection(TSmaccSignal &signal, TMemberFunctionPrototype callback, TSmaccObjectType *object);
 
@@ -118,6 +136,12 @@ protected:
 
     void onInitialized();
 
+    // blocks until the client connections are up or the warm-up deadline expires (see ConnectionWarmup)
+    void waitForConnections();
+
+    // publishes and prints the report of the StartupProfiler
+    void publishStartupReport();
+
     template <typename TOrthogonal>
     void createOrthogonal();
 
@@ -141,7 +165,9 @@ protected:
     ros::Publisher stateMachinePub_;
     ros::Publisher stateMachineStatusPub_;
     ros::Publisher transitionLogPub_;
+    ros::Publisher startupReportPub_;
     ros::ServiceServer transitionHistoryService_;
+    ros::ServiceServer dumpTraceService_;
 
     // if it is null, you may be located in a transition. There is a small gap of time where internally
     // this currentState_ is null. This may change in the future.
@@ -154,6 +180,9 @@ protected:
     // orthogonals
     std::map<std::string, std::shared_ptr<smacc::ISmaccOrthogonal>> orthogonals_;
 
+    // components not owned by any client, created on demand by requiresComponent
+    std::map<std::string, std::shared_ptr<smacc::ISmaccComponent>> components_;
+
 private:
     std::recursive_mutex m_mutex_;
 
@@ -171,8 +200,16 @@ private:
 
     unsigned long stateSeqCounter_;
 
+    // timers of the delayed events not posted yet
+    std::mutex delayedEventsMutex_;
+    std::map<unsigned long, TimerWheel::TimerId> delayedEvents_;
+    unsigned long delayedEventsCounter_;
+
+    ClientInitializer clientInitializer_;
+
     friend class ISmaccState;
     friend class SignalDetector;
+    friend class ISmaccClient;
 
     void lockStateMachine(std::string msg);
 
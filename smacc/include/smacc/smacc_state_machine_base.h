@@ -8,6 +8,7 @@
 
 #include <smacc/smacc_state_base.h>
 #include <smacc/smacc_state_machine.h>
+#include <smacc/smacc_startup_profiler.h>
 
 namespace smacc
 {
@@ -49,18 +50,56 @@ public:
 
     virtual void initiate_impl() override
     {
+        smacc::tracing::setTraceThreadName("state_machine");
         ROS_INFO("initiate_impl");
+        auto &profiler = StartupProfiler::getInstance();
+        profiler.start();
+
         auto shortname = smacc::utils::cleanShortTypeName(typeid(DerivedStateMachine));
-        this->onInitializing(shortname);
+        {
+            StartupProfiler::Scope scope("phase", "onInitializing");
+            this->getClientInitializer().begin();
+            this->onInitializing(shortname);
+        }
+
+        {
+            StartupProfiler::Scope scope("phase", "initializeClients");
+            this->getClientInitializer().run();
+        }
 
         ROS_INFO("Introspecting state machine via typeWalker");
-        this->buildStateMachineInfo<InitialStateType>();
+        {
+            StartupProfiler::Scope scope("phase", "buildStateMachineInfo");
+            this->buildStateMachineInfo<InitialStateType>();
+        }
 
         ROS_INFO("Initializing ROS communication mechanisms");
-        this->onInitialized();
+        {
+            StartupProfiler::Scope scope("phase", "onInitialized");
+            this->onInitialized();
+        }
+
+        ROS_INFO("Waiting for the client connections");
+        {
+            StartupProfiler::Scope scope("phase", "waitForConnections");
+            this->waitForConnections();
+        }
 
         ROS_INFO("Initializing state machine");
-        sc::state_machine<DerivedStateMachine, InitialStateType, SmaccAllocator>::initiate();
+        {
+            StartupProfiler::Scope scope("phase", "initial state entry");
+            sc::state_machine<DerivedStateMachine, InitialStateType, SmaccAllocator>::initiate();
+        }
+
+        profiler.stop();
+        this->publishStartupReport();
+    }
+
+    // the scheduler thread calls this method when the event is dequeued
+    virtual void process_event_impl(const sc::event_base &evt) override
+    {
+        SMACC_TRACE_SCOPE_TYPE("event_dispatch", typeid(evt));
+        sc::state_machine<DerivedStateMachine, InitialStateType, SmaccAllocator>::process_event(evt);
     }
 };
 } // namespace smacc
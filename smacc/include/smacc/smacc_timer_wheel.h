@@ -0,0 +1,131 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <ros/duration.h>
+#include <ros/time.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace smacc
+{
+// Process wide timer service. A single thread serves all the SMACC timers (timer clients, sensor watchdogs,
+// periodic updatables, delayed events...) with a hierarchical timing wheel: 4 levels of 256 slots, so
+// scheduling, cancelling and expiring a timer are O(1) regardless of the amount of timers.
+//
+// The wheel follows ros::Time (it also works with simulated time). Its resolution is the ros parameter
+// ~timer_wheel_resolution (seconds, default 0.001). Callbacks are executed in the timer wheel thread, they
+// must be short and thread safe (ie: post an event or a continuation).
+//
+// The thread sleeps until the next slot that holds timers, and the wheel jumps over the empty slots, so
+// neither an idle wheel nor a forward jump of ros::Time costs a wake-up per tick.
+class TimerWheel
+{
+public:
+    typedef uint64_t TimerId;
+
+    static TimerWheel &getInstance();
+
+    ~TimerWheel();
+
+    // The callback is called after delay, and then every period if period is not zero.
+    // Returns an id for cancel
+    TimerId schedule(ros::Duration delay, std::function<void()> callback, ros::Duration period = ros::Duration(0));
+
+    // Once it returns the callback is not executing (unless it is called from the callback itself) and it
+    // will not be called again
+    void cancel(TimerId timer);
+
+    // current time in ticks, from ros::Time (the wheel itself only advances when its thread wakes up). It takes
+    // no lock, used for cheap timestamps (see SmaccWatchdog)
+    uint64_t currentTick() const;
+
+    inline ros::Duration getResolution() const { return ros::Duration(resolution_); }
+
+    uint64_t toTicks(ros::Duration duration) const;
+
+private:
+    TimerWheel();
+
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+    struct Timer
+    {
+        uint64_t expiry;
+        uint64_t period;
+        std::function<void()> callback;
+    };
+
+    // ticks since origin_
+    std::atomic<uint64_t> now_;
+    ros::Time origin_;
+    double resolution_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable callbackDone_;
+
+    std::unordered_map<TimerId, Timer> timers_;
+    std::vector<TimerId> slots_[LEVELS][SLOTS];
+    TimerId nextId_;
+
+    // timer whose callback is being executed (0 if none)
+    TimerId executingTimer_;
+
+    bool shutdown_;
+    std::thread thread_;
+
+    void insert(TimerId id, uint64_t expiry);
+
+    void cascade(int level);
+
+    // advances the wheel one tick and collects the expired timers. target is the tick of the current time,
+    // the periods of the periodic timers missed until then are skipped
+    void tick(uint64_t target, std::vector<std::pair<TimerId, std::function<void()>>> &expired);
+
+    // first tick after now_ that expires or cascades some slot. max uint64_t if the wheel is empty
+    uint64_t nextEventTick() const;
+
+    void run();
+};
+
+// Timeout watchdog (ie: sensor message timeout). feed() only stores a timestamp, it does not restart any timer,
+// so it can be called at high rates. The timeout callback is called every timeout while it is not fed.
+// stop() does not wait for a timeout callback already in progress (it may be waiting for a lock of the caller).
+class SmaccWatchdog
+{
+public:
+    SmaccWatchdog();
+
+    ~SmaccWatchdog();
+
+    void start(ros::Duration timeout, std::function<void()> onTimeout);
+
+    void stop();
+
+    inline void feed() { lastFeed_.store(TimerWheel::getInstance().currentTick(), std::memory_order_relaxed); }
+
+private:
+    // the timeout callback is called without holding it, so it may restart or stop the watchdog
+    std::mutex mutex_;
+    TimerWheel::TimerId timer_;
+    uint64_t timeoutTicks_;
+    std::function<void()> onTimeout_;
+    std::atomic<uint64_t> lastFeed_;
+
+    void arm(uint64_t deadline);
+
+    void check();
+};
+} // namespace smacc
@@ -0,0 +1,136 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace smacc
+{
+namespace tracing
+{
+// The kind of name stored in a trace record. Mangled type names (ie: typeid(T).name()) are stored
+// as raw pointers and only demangled when the trace is exported, so recording them costs nothing.
+enum class TraceNameKind : uint8_t
+{
+    LITERAL,
+    MANGLED_TYPE
+};
+
+// A single trace record. Only pointers to static strings (literals or type_info names) are stored.
+struct TraceRecord
+{
+    const char *category;
+    const char *name;
+    TraceNameKind nameKind;
+    char phase; // chrome trace-event phase: 'X' (complete) or 'i' (instant)
+    uint64_t timestampNs;
+    uint64_t durationNs;
+};
+
+extern std::atomic<bool> tracingEnabled_;
+
+// Returns true if the tracing layer is recording. When disabled, every instrumentation point
+// reduces to this relaxed atomic load and a branch.
+inline bool isTracingEnabled()
+{
+    return tracingEnabled_.load(std::memory_order_relaxed);
+}
+
+void setTracingEnabled(bool enabled);
+
+// monotonic timestamp in nanoseconds
+inline uint64_t traceNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Appends a record into the thread local buffer of the calling thread
+void traceRecord(const TraceRecord &record);
+
+void traceInstant(const char *category, const char *name, TraceNameKind nameKind = TraceNameKind::LITERAL);
+
+// Names the calling thread in the exported trace
+void setTraceThreadName(const char *name);
+
+// Discards all the recorded events
+void clearTrace();
+
+// Writes all the recorded events (of all threads) with the Chrome trace-event JSON format.
+// The output can be loaded in chrome://tracing or in the Perfetto UI (ui.perfetto.dev)
+bool dumpChromeTrace(const std::string &filepath, std::string &errorMessage);
+
+// RAII helper that records a complete event ('X') for the lifetime of the scope
+class ScopedTrace
+{
+public:
+    inline ScopedTrace(const char *category, const char *name, TraceNameKind nameKind = TraceNameKind::LITERAL)
+        : startNs_(0)
+    {
+        if (isTracingEnabled())
+        {
+            category_ = category;
+            name_ = name;
+            nameKind_ = nameKind;
+            startNs_ = traceNow();
+        }
+    }
+
+    inline ~ScopedTrace()
+    {
+        if (startNs_ != 0)
+        {
+            TraceRecord record;
+            record.category = category_;
+            record.name = name_;
+            record.nameKind = nameKind_;
+            record.phase = 'X';
+            record.timestampNs = startNs_;
+            record.durationNs = traceNow() - startNs_;
+            traceRecord(record);
+        }
+    }
+
+    ScopedTrace(const ScopedTrace &) = delete;
+    ScopedTrace &operator=(const ScopedTrace &) = delete;
+
+private:
+    uint64_t startNs_;
+    const char *category_;
+    const char *name_;
+    TraceNameKind nameKind_;
+};
+} // namespace tracing
+} // namespace smacc
+
+#define SMACC_TRACE_CONCAT_INNER(a, b) a##b
+#define SMACC_TRACE_CONCAT(a, b) SMACC_TRACE_CONCAT_INNER(a, b)
+
+// traces the current scope with a string literal name
+#define SMACC_TRACE_SCOPE(category, name) \
+    smacc::tracing::ScopedTrace SMACC_TRACE_CONCAT(smacc_trace_scope_, __LINE__)(category, name)
+
+// traces the current scope with the (lazily demangled) name of the given type_info
+#define SMACC_TRACE_SCOPE_TYPE(category, tinfo) \
+    smacc::tracing::ScopedTrace SMACC_TRACE_CONCAT(smacc_trace_scope_, __LINE__)(category, (tinfo).name(), smacc::tracing::TraceNameKind::MANGLED_TYPE)
+
+#define SMACC_TRACE_INSTANT(category, name)           \
+    do                                                \
+    {                                                 \
+        if (smacc::tracing::isTracingEnabled())       \
+            smacc::tracing::traceInstant(category, name); \
+    } while (0)
+
+#define SMACC_TRACE_INSTANT_TYPE(category, tinfo)                                                               \
+    do                                                                                                          \
+    {                                                                                                           \
+        if (smacc::tracing::isTracingEnabled())                                                                 \
+            smacc::tracing::traceInstant(category, (tinfo).name(), smacc::tracing::TraceNameKind::MANGLED_TYPE); \
+    } while (0)
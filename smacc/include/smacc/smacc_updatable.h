@@ -5,27 +5,77 @@
  ******************************************************************************************************************/
 
 #pragma once
+#include <atomic>
 #include <chrono>
+#include <mutex>
+#include <vector>
 #include <boost/optional.hpp>
 #include <ros/duration.h>
 #include <ros/time.h>
+#include <smacc/smacc_timer_wheel.h>
 
 namespace smacc
 {
+// Rolling execution time statistics of the update() method of an updatable object.
+// mean, p99 and max are computed over the last UPDATE_STATISTICS_WINDOW executions.
+struct UpdateStatistics
+{
+    ros::Duration last;
+    ros::Duration mean;
+    ros::Duration p99;
+    ros::Duration max;
+
+    boost::optional<ros::Duration> budget;
+
+    // total amount of update calls and the amount of them that exceeded the budget
+    unsigned long count;
+    unsigned long overruns;
+};
+
 class ISmaccUpdatable
 {
 public:
     ISmaccUpdatable();
     ISmaccUpdatable(ros::Duration duration);
 
+    virtual ~ISmaccUpdatable();
+
     void executeUpdate();
     void setUpdatePeriod(ros::Duration duration);
 
+    // sets the maximum expected execution time of the update() method. Every update call
+    // that exceeds it is logged and reported as a warning on /diagnostics
+    void setUpdateBudget(ros::Duration budget);
+
+    boost::optional<ros::Duration> getUpdateBudget();
+
+    UpdateStatistics getUpdateStatistics();
+
 protected:
     virtual void update() = 0;
 
 private:
     boost::optional<ros::Duration> periodDuration_;
-    ros::Time lastUpdate_;
+
+    // the period is measured by a periodic timer of the timer wheel, so the signal detector only reads a flag
+    TimerWheel::TimerId periodTimer_;
+    std::atomic<bool> updateDue_;
+
+    // ---- execution time monitoring ----
+    std::mutex statisticsMutex_;
+    boost::optional<ros::Duration> budget_;
+    std::vector<double> samples_; // seconds, circular buffer
+    size_t nextSample_;
+    unsigned long updateCount_;
+    unsigned long overrunCount_;
+    std::chrono::steady_clock::time_point lastOverrunWarning_;
+
+    // used by the signal detector to report only the overruns that happened since the last report
+    unsigned long reportedOverrunCount_;
+    bool budgetConfigured_;
+
+    void registerUpdateDuration(double ellapsedSeconds);
+
+    friend class SignalDetector;
 };
-} // namespace smacc
\ No newline at end of file
+} // namespace smacc
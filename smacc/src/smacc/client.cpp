@@ -11,6 +11,7 @@
 namespace smacc
 {
 ISmaccClient::ISmaccClient()
+    : serialInitialization_(false)
 {
 }
 
@@ -22,6 +23,16 @@ void ISmaccClient::initialize()
 {
 }
 
+bool ISmaccClient::requiresConnection()
+{
+    return false;
+}
+
+bool ISmaccClient::isConnected()
+{
+    return true;
+}
+
 std::string ISmaccClient::getName() const
 {
     std::string keyname = demangleSymbol(typeid(*this).name());
@@ -38,6 +49,19 @@ void ISmaccClient::setOrthogonal(ISmaccOrthogonal* orthogonal)
     orthogonal_ = orthogonal;
 }
 
+void ISmaccClient::setCallbackQueue(std::shared_ptr<ClientCallbackQueue> callbackQueue)
+{
+    callbackQueue_ = callbackQueue;
+}
+
+ros::CallbackQueueInterface *ISmaccClient::getCallbackQueue()
+{
+    if (callbackQueue_ != nullptr)
+        return callbackQueue_->getQueue();
+    else
+        return ros::getGlobalCallbackQueue();
+}
+
 smacc::introspection::TypeInfo::Ptr ISmaccClient::getType()
 {
     return smacc::introspection::TypeInfo::getFromStdTypeInfo(typeid(*this));
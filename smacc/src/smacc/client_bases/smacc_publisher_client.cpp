@@ -0,0 +1,102 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/client_bases/smacc_publisher_client.h>
+#include <algorithm>
+
+namespace smacc
+{
+namespace client_bases
+{
+SmaccPublisherClient::SmaccPublisherClient()
+    : publishMode(PublishMode::DIRECT),
+      sendQueueSize(10),
+      initialized_(false),
+      stopSender_(false),
+      droppedMessages_(0)
+{
+}
+
+SmaccPublisherClient::~SmaccPublisherClient()
+{
+    {
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        stopSender_ = true;
+    }
+    sendCondition_.notify_one();
+
+    if (senderThread_.joinable())
+        senderThread_.join();
+
+    pub_.shutdown();
+}
+
+unsigned long SmaccPublisherClient::getDroppedMessages() const
+{
+    return droppedMessages_;
+}
+
+void SmaccPublisherClient::enqueue(std::function<void()> sendMessage)
+{
+    bool dropped = false;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        if (!senderThread_.joinable())
+        {
+            senderThread_ = std::thread(&SmaccPublisherClient::senderLoop, this);
+        }
+
+        if ((int)sendQueue_.size() >= std::max(1, sendQueueSize))
+        {
+            if (publishMode == PublishMode::QUEUED_DROP_NEWEST)
+            {
+                dropped = true;
+            }
+            else
+            {
+                // replacing the oldest message is the expected behavior of this mode, it is not a drop
+                sendQueue_.pop_front();
+                sendQueue_.push_back(std::move(sendMessage));
+            }
+        }
+        else
+        {
+            sendQueue_.push_back(std::move(sendMessage));
+        }
+    }
+
+    if (dropped)
+    {
+        droppedMessages_++;
+        ROS_WARN_THROTTLE(1, "[%s] send queue full, dropping messages", this->getName().c_str());
+        return;
+    }
+
+    sendCondition_.notify_one();
+}
+
+void SmaccPublisherClient::senderLoop()
+{
+    auto threadName = "publisher_" + (topicName ? *topicName : std::string());
+    smacc::tracing::setTraceThreadName(threadName.c_str());
+
+    std::unique_lock<std::mutex> lock(sendMutex_);
+    while (true)
+    {
+        sendCondition_.wait(lock, [this] { return stopSender_ || !sendQueue_.empty(); });
+        if (stopSender_)
+            return;
+
+        auto sendMessage = std::move(sendQueue_.front());
+        sendQueue_.pop_front();
+
+        // serialization and socket writes happen out of the lock
+        lock.unlock();
+        sendMessage();
+        lock.lock();
+    }
+}
+} // namespace client_bases
+} // namespace smacc
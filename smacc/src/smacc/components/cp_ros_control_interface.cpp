@@ -14,6 +14,7 @@ namespace components
 using namespace controller_manager_msgs;
 
 CpRosControlInterface::CpRosControlInterface()
+    : asyncCalls_(1)
 {
 }
 
@@ -107,5 +108,38 @@ bool CpRosControlInterface::switchControllers(std::vector<std::string> start_con
 
     return res.ok;
 }
+
+unsigned long CpRosControlInterface::listControllersAsync(std::function<void(bool, const std::vector<controller_manager_msgs::ControllerState> &)> onDone,
+                                                         ros::Duration timeout)
+{
+    ListControllers::Request req;
+    return asyncCalls_.call<ListControllers>(srvListControllers.getService(), req, timeout,
+                                             [onDone](unsigned long, bool success, const ListControllers::Response &res, const std::string &error) {
+                                                 if (!success)
+                                                     ROS_WARN("[CpRosControlInterface] %s", error.c_str());
+
+                                                 onDone(success, res.controller);
+                                             });
+}
+
+unsigned long CpRosControlInterface::switchControllersAsync(std::vector<std::string> start_controllers,
+                                                           std::vector<std::string> stop_controllers,
+                                                           Strictness strictness,
+                                                           std::function<void(bool)> onDone,
+                                                           ros::Duration timeout)
+{
+    SwitchController::Request req;
+    req.start_controllers = start_controllers;
+    req.stop_controllers = stop_controllers;
+    req.strictness = strictness;
+
+    return asyncCalls_.call<SwitchController>(srvSwitchControllers.getService(), req, timeout,
+                                              [onDone](unsigned long, bool success, const SwitchController::Response &res, const std::string &error) {
+                                                  if (!success)
+                                                      ROS_WARN("[CpRosControlInterface] %s", error.c_str());
+
+                                                  onDone(success && res.ok);
+                                              });
+}
+}
 }
-}
\ No newline at end of file
@@ -0,0 +1,167 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/client_base_components/cp_tf_listener.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace smacc
+{
+namespace components
+{
+namespace
+{
+struct TransformSubscription
+{
+    std::string targetFrame;
+    std::string sourceFrame;
+    CpTfListener::TransformCallback callback;
+
+    // guards lastStamp and active, and it is held while the callback executes
+    std::recursive_mutex callbackMutex;
+    ros::Time lastStamp;
+    bool active;
+};
+
+// tf data shared by all the CpTfListener instances of the process
+class SharedTfState
+{
+public:
+    SharedTfState()
+        : listener(buffer), nextId(1)
+    {
+        // same mechanism tf2_ros::MessageFilter uses to wake up when new transforms arrive
+        transformsChangedConnection = buffer._addTransformsChangedListener(boost::bind(&SharedTfState::onTransformsChanged, this));
+    }
+
+    tf2_ros::Buffer buffer;
+    tf2_ros::TransformListener listener;
+
+    // guards the subscription table only. The lookups and the callbacks are done out of it, so a slow
+    // callback does not block the rest of subscribers nor (un)subscribing
+    std::mutex mutex;
+    std::map<unsigned long, std::shared_ptr<TransformSubscription>> subscriptions;
+    unsigned long nextId;
+
+    boost::signals2::connection transformsChangedConnection;
+
+    void onTransformsChanged()
+    {
+        std::vector<std::shared_ptr<TransformSubscription>> due;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto &entry : subscriptions)
+                due.push_back(entry.second);
+        }
+
+        for (auto &subscription : due)
+            notify(*subscription);
+    }
+
+    void notify(TransformSubscription &subscription)
+    {
+        geometry_msgs::TransformStamped transform;
+        try
+        {
+            transform = buffer.lookupTransform(subscription.targetFrame, subscription.sourceFrame, ros::Time(0));
+        }
+        catch (const tf2::TransformException &)
+        {
+            // not transformable yet
+            return;
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(subscription.callbackMutex);
+        if (!subscription.active)
+            return;
+
+        // only newer transforms are notified. Static transforms (stamp 0) are notified once
+        if (transform.header.stamp > subscription.lastStamp || (subscription.lastStamp.isZero() && transform.header.stamp.isZero()))
+        {
+            subscription.lastStamp = transform.header.stamp.isZero() ? ros::TIME_MIN : transform.header.stamp;
+            subscription.callback(transform);
+        }
+    }
+};
+
+SharedTfState &getSharedTfState()
+{
+    // intentionally never destroyed: the listener thread must not be joined during static destruction
+    static SharedTfState *state = new SharedTfState();
+    return *state;
+}
+} // namespace
+
+CpTfListener::CpTfListener()
+{
+}
+
+CpTfListener::~CpTfListener()
+{
+}
+
+tf2_ros::Buffer &CpTfListener::getBuffer()
+{
+    return getSharedTfState().buffer;
+}
+
+boost::optional<geometry_msgs::TransformStamped> CpTfListener::lookupTransform(const std::string &targetFrame, const std::string &sourceFrame,
+                                                                               ros::Time time)
+{
+    try
+    {
+        return getSharedTfState().buffer.lookupTransform(targetFrame, sourceFrame, time);
+    }
+    catch (const tf2::TransformException &ex)
+    {
+        ROS_ERROR_STREAM_THROTTLE(1, "[CpTfListener] transform " << sourceFrame << " -> " << targetFrame << " not available: " << ex.what());
+        return boost::none;
+    }
+}
+
+unsigned long CpTfListener::subscribeTransform(const std::string &targetFrame, const std::string &sourceFrame, TransformCallback callback)
+{
+    auto &state = getSharedTfState();
+    auto subscription = std::make_shared<TransformSubscription>();
+    subscription->targetFrame = targetFrame;
+    subscription->sourceFrame = sourceFrame;
+    subscription->callback = callback;
+    subscription->lastStamp = ros::Time(0);
+    subscription->active = true;
+
+    unsigned long id;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        id = state.nextId++;
+        state.subscriptions[id] = subscription;
+    }
+
+    // notify the current transform if it is already available
+    state.notify(*subscription);
+    return id;
+}
+
+void CpTfListener::unsubscribeTransform(unsigned long subscriptionId)
+{
+    auto &state = getSharedTfState();
+    std::shared_ptr<TransformSubscription> subscription;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        auto it = state.subscriptions.find(subscriptionId);
+        if (it == state.subscriptions.end())
+            return;
+
+        subscription = it->second;
+        state.subscriptions.erase(it);
+    }
+
+    // waits for a callback in progress (recursive: it may be called from the callback itself)
+    std::lock_guard<std::recursive_mutex> lock(subscription->callbackMutex);
+    subscription->active = false;
+}
+} // namespace components
+} // namespace smacc
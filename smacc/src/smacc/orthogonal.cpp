@@ -1,5 +1,6 @@
 #include <smacc/impl/smacc_state_machine_impl.h>
 #include <smacc/smacc_client_behavior.h>
+#include <smacc/smacc_asynchronous_client_behavior.h>
 #include <smacc/smacc_orthogonal.h>
 
 namespace smacc
@@ -14,7 +15,7 @@ namespace smacc
   {
     if (clBehavior != nullptr)
     {
-      ROS_INFO("[Orthogonal %s] adding client behavior: %s", this->getName().c_str(), clBehavior->getName().c_str());
+      SMACC_LOG_INFO("[Orthogonal {}] adding client behavior: {}", typeid(*this), typeid(*clBehavior));
       clBehavior->stateMachine_ = this->getStateMachine();
       clBehavior->currentOrthogonal = this;
 
@@ -22,7 +23,7 @@ namespace smacc
     }
     else
     {
-      ROS_INFO("[orthogonal %s] no client behaviors in this state", this->getName().c_str());
+      SMACC_LOG_INFO("[orthogonal {}] no client behaviors in this state", typeid(*this));
     }
   }
 
@@ -39,17 +40,18 @@ namespace smacc
   {
     for (auto &clBehavior : clientBehaviors_)
     {
-      ROS_INFO("[Orthogonal %s] runtimeConfigure, current Behavior: %s", this->getName().c_str(),
-               clBehavior->getName().c_str());
+      SMACC_LOG_INFO("[Orthogonal {}] runtimeConfigure, current Behavior: {}", typeid(*this), typeid(*clBehavior));
 
       clBehavior->runtimeConfigure();
     }
   }
 
-  void ISmaccOrthogonal::assignClientToOrthogonal(smacc::ISmaccClient *client)
+  void ISmaccOrthogonal::assignClientToOrthogonal(smacc::ISmaccClient *client, const std::type_info &clientType)
   {
     client->setStateMachine(getStateMachine());
     client->setOrthogonal(this);
+    client->shortTypeName_ = smacc::utils::cleanShortTypeName(clientType);
+    client->setCallbackQueue(ClientCallbackQueue::create(client->shortTypeName_));
   }
 
   void ISmaccOrthogonal::onEntry()
@@ -58,10 +60,11 @@ namespace smacc
     {
       for (auto &clBehavior : clientBehaviors_)
       {
-        ROS_INFO("[Orthogonal %s] OnEntry, current Behavior: %s", this->getName().c_str(), clBehavior->getName().c_str());
+        SMACC_LOG_INFO("[Orthogonal {}] OnEntry, current Behavior: {}", typeid(*this), typeid(*clBehavior));
 
         try
         {
+          SMACC_TRACE_SCOPE_TYPE("behavior_entry", typeid(*clBehavior));
           clBehavior->onEntry();
         }
         catch (const std::exception &e)
@@ -73,7 +76,7 @@ namespace smacc
     }
     else
     {
-      ROS_INFO("[Orthogonal %s] OnEntry", this->getName().c_str());
+      SMACC_LOG_INFO("[Orthogonal {}] OnEntry", typeid(*this));
     }
   }
 
@@ -83,9 +86,18 @@ namespace smacc
     {
       for (auto &clBehavior : clientBehaviors_)
       {
-        ROS_INFO("[Orthogonal %s] OnExit, current Behavior: %s", this->getName().c_str(), clBehavior->getName().c_str());
+        SMACC_LOG_INFO("[Orthogonal {}] OnExit, current Behavior: {}", typeid(*this), typeid(*clBehavior));
+
+        // pending asynchronous continuations of the behavior must not be executed once the state is left
+        auto asyncBehavior = std::dynamic_pointer_cast<SmaccAsyncClientBehavior>(clBehavior);
+        if (asyncBehavior != nullptr)
+        {
+          asyncBehavior->cancelAsync();
+        }
+
         try
         {
+          SMACC_TRACE_SCOPE_TYPE("behavior_exit", typeid(*clBehavior));
           clBehavior->onExit();
         }
         catch (const std::exception &e)
@@ -97,7 +109,7 @@ namespace smacc
     }
     else
     {
-      ROS_INFO("[Orthogonal %s] OnExit", this->getName().c_str());
+      SMACC_LOG_INFO("[Orthogonal {}] OnExit", typeid(*this));
     }
   }
 } // namespace smacc
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <smacc/smacc_signal_detector.h>
 #include <smacc/client_bases/smacc_action_client_base.h>
 #include <smacc/smacc_state_machine.h>
+#include <diagnostic_msgs/DiagnosticArray.h>
 #include <thread>
 
 namespace smacc
@@ -20,6 +21,7 @@ SignalDetector::SignalDetector(SmaccFifoScheduler *scheduler)
     scheduler_ = scheduler;
     loop_rate_hz = 20.0;
     end_ = false;
+    pendingOverrunDiagnostics_ = false;
 }
 
 /**
@@ -32,6 +34,8 @@ void SignalDetector::initialize(ISmaccStateMachine *stateMachine)
     smaccStateMachine_ = stateMachine;
     lastState_ = std::numeric_limits<unsigned long>::quiet_NaN();
     findUpdatableClients();
+
+    diagnosticsPub_ = nh_.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 1);
 }
 
 /**
@@ -117,6 +121,108 @@ void SignalDetector::findUpdatableStateElements(ISmaccState *currentState)
     }
 }
 
+/**
+******************************************************************************************************************
+* configureUpdateBudget()
+******************************************************************************************************************
+*/
+void SignalDetector::configureUpdateBudget(ISmaccUpdatable *updatable)
+{
+    ros::NodeHandle nh("~");
+    double budget;
+    auto paramName = "update_budgets/" + smacc::utils::cleanShortTypeName(typeid(*updatable));
+    if (nh.getParam(paramName, budget))
+    {
+        ROS_INFO_STREAM("[SignalDetector] update budget of " << demangleType(typeid(*updatable)) << " (ros param ~" << paramName << "): " << budget << " s");
+        updatable->setUpdateBudget(ros::Duration(budget));
+    }
+
+    updatable->budgetConfigured_ = true;
+}
+
+/**
+******************************************************************************************************************
+* executeUpdatable()
+******************************************************************************************************************
+*/
+void SignalDetector::executeUpdatable(ISmaccUpdatable *updatable)
+{
+    if (!updatable->budgetConfigured_)
+    {
+        this->configureUpdateBudget(updatable);
+    }
+
+    SMACC_TRACE_SCOPE_TYPE("update", typeid(*updatable));
+    auto overrunsBefore = updatable->overrunCount_;
+    updatable->executeUpdate();
+
+    if (updatable->overrunCount_ != overrunsBefore)
+    {
+        pendingOverrunDiagnostics_ = true;
+    }
+}
+
+/**
+******************************************************************************************************************
+* publishUpdateDiagnostics()
+******************************************************************************************************************
+*/
+void SignalDetector::publishUpdateDiagnostics()
+{
+    diagnostic_msgs::DiagnosticArray diagnostics;
+    diagnostics.header.stamp = ros::Time::now();
+
+    auto hardwareId = smaccStateMachine_->getStateMachineName();
+
+    auto addStatus = [&](ISmaccUpdatable *updatable) {
+        auto stats = updatable->getUpdateStatistics();
+
+        diagnostic_msgs::DiagnosticStatus status;
+        status.name = "smacc/update/" + demangleType(typeid(*updatable));
+        status.hardware_id = hardwareId;
+
+        if (stats.overruns != updatable->reportedOverrunCount_)
+        {
+            status.level = diagnostic_msgs::DiagnosticStatus::WARN;
+            status.message = "update budget overrun";
+            updatable->reportedOverrunCount_ = stats.overruns;
+        }
+        else
+        {
+            status.level = diagnostic_msgs::DiagnosticStatus::OK;
+            status.message = "ok";
+        }
+
+        auto addValue = [&](std::string key, std::string value) {
+            diagnostic_msgs::KeyValue kv;
+            kv.key = key;
+            kv.value = value;
+            status.values.push_back(kv);
+        };
+
+        addValue("last_ms", std::to_string(stats.last.toSec() * 1000.0));
+        addValue("mean_ms", std::to_string(stats.mean.toSec() * 1000.0));
+        addValue("p99_ms", std::to_string(stats.p99.toSec() * 1000.0));
+        addValue("max_ms", std::to_string(stats.max.toSec() * 1000.0));
+        addValue("budget_ms", stats.budget ? std::to_string(stats.budget->toSec() * 1000.0) : std::string("none"));
+        addValue("count", std::to_string(stats.count));
+        addValue("overruns", std::to_string(stats.overruns));
+
+        diagnostics.status.push_back(status);
+    };
+
+    for (auto *updatable : this->updatableClients_)
+        addStatus(updatable);
+
+    for (auto *updatable : this->updatableStateElements_)
+        addStatus(updatable);
+
+    diagnosticsPub_.publish(diagnostics);
+
+    lastDiagnosticsPublish_ = diagnostics.header.stamp;
+    pendingOverrunDiagnostics_ = false;
+}
+
 /**
 ******************************************************************************************************************
 * setProcessorHandle()
@@ -171,9 +277,12 @@ void SignalDetector::pollOnce()
         return;
     }
 
+    SMACC_TRACE_SCOPE("signal_detector", "pollOnce");
     try
     {
         smaccStateMachine_->lockStateMachine("update behaviors");
+        this->executeContinuations();
+
         this->findUpdatableClients();
         ROS_DEBUG_STREAM("updatable clients: " << this->updatableClients_.size());
 
@@ -182,7 +291,7 @@ void SignalDetector::pollOnce()
             for (auto *updatableClient : this->updatableClients_)
             {
                 ROS_DEBUG_STREAM("[PollOnce] update client call:  " << demangleType(typeid(updatableClient)));
-                updatableClient->executeUpdate();
+                this->executeUpdatable(updatableClient);
             }
         }
 
@@ -210,10 +319,17 @@ void SignalDetector::pollOnce()
                 for (auto *udpatableStateElement : this->updatableStateElements_)
                 {
                     ROS_DEBUG_STREAM("pollOnce update client behavior call: " << demangleType(typeid(*udpatableStateElement)));
-                    udpatableStateElement->executeUpdate();
+                    this->executeUpdatable(udpatableStateElement);
                 }
             }
         }
+
+        // periodic report (1hz) or early report if some update exceeded its budget (at most 5hz)
+        auto sinceLastPublish = (ros::Time::now() - lastDiagnosticsPublish_).toSec();
+        if ((pendingOverrunDiagnostics_ && sinceLastPublish > 0.2) || sinceLastPublish > 1.0)
+        {
+            this->publishUpdateDiagnostics();
+        }
     }
     catch (...)
     {
@@ -222,6 +338,44 @@ void SignalDetector::pollOnce()
     smaccStateMachine_->unlockStateMachine("update behaviors");
 }
 
+/**
+******************************************************************************************************************
+* postContinuation()
+******************************************************************************************************************
+*/
+void SignalDetector::postContinuation(std::function<void()> continuation)
+{
+    std::lock_guard<std::mutex> lock(continuationsMutex_);
+    continuations_.push_back(continuation);
+}
+
+/**
+******************************************************************************************************************
+* executeContinuations()
+******************************************************************************************************************
+*/
+void SignalDetector::executeContinuations()
+{
+    std::vector<std::function<void()>> pending;
+    {
+        std::lock_guard<std::mutex> lock(continuationsMutex_);
+        pending.swap(continuations_);
+    }
+
+    for (auto &continuation : pending)
+    {
+        SMACC_TRACE_SCOPE("signal_detector", "continuation");
+        try
+        {
+            continuation();
+        }
+        catch (const std::exception &e)
+        {
+            ROS_ERROR("[SignalDetector] exception in asynchronous continuation: %s", e.what());
+        }
+    }
+}
+
 /**
 ******************************************************************************************************************
 * pollingLoop()
@@ -245,12 +399,30 @@ void SignalDetector::pollingLoop()
 
     ROS_INFO_STREAM("[SignalDetector] loop rate hz:" << loop_rate_hz);
 
+    // by default the global callback queue is spun in this loop. Otherwise it is served by a pool of threads,
+    // so the ros callbacks are not serialized behind the updates (see also ClientCallbackQueue)
+    int globalCallbackThreads = 0;
+    nh.getParam("global_callback_threads", globalCallbackThreads);
+
+    std::unique_ptr<ros::AsyncSpinner> globalSpinner;
+    if (globalCallbackThreads > 0)
+    {
+        ROS_INFO_STREAM("[SignalDetector] global callback queue served by " << globalCallbackThreads << " threads (ros param ~global_callback_threads)");
+        globalSpinner.reset(new ros::AsyncSpinner(globalCallbackThreads));
+        globalSpinner->start();
+    }
+
+    smacc::tracing::setTraceThreadName("signal_detector");
+
     ros::Rate r(loop_rate_hz);
     while (ros::ok() && !end_)
     {
         ROS_INFO_STREAM_THROTTLE(10, "[SignalDetector] heartbeat");
         pollOnce();
-        ros::spinOnce();
+
+        if (globalSpinner == nullptr)
+            ros::spinOnce();
+
         r.sleep();
     }
 }
@@ -0,0 +1,79 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_asynchronous_client_behavior.h>
+#include <smacc/smacc_state_machine.h>
+
+namespace smacc
+{
+SmaccAsyncClientBehavior::SmaccAsyncClientBehavior()
+    : cancelled_(false)
+{
+}
+
+SmaccAsyncClientBehavior::~SmaccAsyncClientBehavior()
+{
+}
+
+bool SmaccAsyncClientBehavior::isCancelled() const
+{
+    return cancelled_;
+}
+
+void SmaccAsyncClientBehavior::runAsync(std::function<void()> function, std::function<void()> continuation)
+{
+    auto self = this->shared_from_this();
+    std::thread([self, function, continuation]() {
+        function();
+        if (continuation)
+        {
+            self->resume(continuation);
+        }
+    })
+        .detach();
+}
+
+void SmaccAsyncClientBehavior::delay(ros::Duration duration, std::function<void()> continuation)
+{
+    // the timer only keeps a weak reference, it is stopped when the behavior is cancelled
+    std::weak_ptr<SmaccAsyncClientBehavior> weakSelf = this->shared_from_this();
+    auto timer = TimerWheel::getInstance().schedule(duration, [weakSelf, continuation]() {
+        auto self = weakSelf.lock();
+        if (self != nullptr)
+        {
+            self->resume(continuation);
+        }
+    });
+
+    std::lock_guard<std::mutex> lock(timersMutex_);
+    timers_.push_back(timer);
+}
+
+void SmaccAsyncClientBehavior::resume(std::function<void()> continuation)
+{
+    if (cancelled_)
+        return;
+
+    std::weak_ptr<SmaccAsyncClientBehavior> weakSelf = this->shared_from_this();
+    this->getStateMachine()->postContinuation([weakSelf, continuation]() {
+        // checked again in the state machine thread, the state may have been left meanwhile
+        auto self = weakSelf.lock();
+        if (self != nullptr && !self->cancelled_)
+        {
+            continuation();
+        }
+    });
+}
+
+void SmaccAsyncClientBehavior::cancelAsync()
+{
+    cancelled_ = true;
+
+    std::lock_guard<std::mutex> lock(timersMutex_);
+    for (auto &timer : timers_)
+        TimerWheel::getInstance().cancel(timer);
+    timers_.clear();
+}
+} // namespace smacc
@@ -0,0 +1,83 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_callback_queue.h>
+#include <smacc/smacc_tracing.h>
+#include <ros/ros.h>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+namespace smacc
+{
+std::shared_ptr<ClientCallbackQueue> ClientCallbackQueue::create(std::string clientName)
+{
+    ros::NodeHandle nh("~");
+    auto paramNamespace = "callback_queues/" + clientName;
+    if (!nh.hasParam(paramNamespace))
+    {
+        return nullptr;
+    }
+
+    int threads = 1;
+    std::vector<int> cpus;
+    nh.getParam(paramNamespace + "/threads", threads);
+    nh.getParam(paramNamespace + "/cpus", cpus);
+
+    ROS_INFO_STREAM("[ClientCallbackQueue] dedicated callback queue for " << clientName << " (ros param ~" << paramNamespace
+                                                                          << "): " << threads << " threads, " << cpus.size() << " pinned cpus");
+
+    return std::make_shared<ClientCallbackQueue>(clientName, std::max(1, threads), cpus);
+}
+
+ClientCallbackQueue::ClientCallbackQueue(std::string name, int threads, std::vector<int> cpus)
+    : name_(name), stop_(false)
+{
+    for (int i = 0; i < threads; i++)
+    {
+        threads_.push_back(std::thread(&ClientCallbackQueue::spin, this));
+
+        if (!cpus.empty())
+        {
+#ifdef __linux__
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            for (auto cpu : cpus)
+                CPU_SET(cpu, &cpuset);
+
+            int error = pthread_setaffinity_np(threads_.back().native_handle(), sizeof(cpu_set_t), &cpuset);
+            if (error != 0)
+            {
+                ROS_WARN("[ClientCallbackQueue] %s: could not pin the callback thread (error %d)", name_.c_str(), error);
+            }
+#else
+            ROS_WARN("[ClientCallbackQueue] %s: thread pinning is not supported in this platform", name_.c_str());
+#endif
+        }
+    }
+}
+
+ClientCallbackQueue::~ClientCallbackQueue()
+{
+    stop_ = true;
+    queue_.disable();
+
+    for (auto &thread : threads_)
+        thread.join();
+}
+
+void ClientCallbackQueue::spin()
+{
+    auto threadName = "callbacks_" + name_;
+    smacc::tracing::setTraceThreadName(threadName.c_str());
+
+    while (!stop_ && ros::ok())
+    {
+        queue_.callAvailable(ros::WallDuration(0.1));
+    }
+}
+} // namespace smacc
@@ -10,7 +10,7 @@ namespace smacc
 
     SmaccClientBehavior::~SmaccClientBehavior()
     {
-        ROS_WARN("Client behavior deallocated.");
+        SMACC_LOG_WARN("Client behavior deallocated.");
     }
 
     std::string SmaccClientBehavior::getName() const
@@ -20,16 +20,16 @@ namespace smacc
 
     void SmaccClientBehavior::onEntry()
     {
-        ROS_DEBUG("[%s] Default empty SmaccClientBehavior onEntry", this->getName().c_str());
+        SMACC_LOG_DEBUG("[{}] Default empty SmaccClientBehavior onEntry", typeid(*this));
     }
 
     void SmaccClientBehavior::runtimeConfigure()
     {
-        ROS_DEBUG("[%s] Default empty SmaccClientBehavior runtimeConfigure", this->getName().c_str());
+        SMACC_LOG_DEBUG("[{}] Default empty SmaccClientBehavior runtimeConfigure", typeid(*this));
     }
 
     void SmaccClientBehavior::onExit()
     {
-        ROS_DEBUG("[%s] Default empty SmaccClientBehavior onExit", this->getName().c_str());
+        SMACC_LOG_DEBUG("[{}] Default empty SmaccClientBehavior onExit", typeid(*this));
     }
 } // namespace smacc
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_client_initializer.h>
+#include <smacc/smacc_client.h>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+
+namespace smacc
+{
+ClientInitializer::ClientInitializer()
+    : deferring_(false), threads_(0)
+{
+}
+
+/**
+******************************************************************************************************************
+* begin()
+******************************************************************************************************************
+*/
+void ClientInitializer::begin()
+{
+    ros::NodeHandle nh("~");
+    threads_ = 0;
+    nh.getParam("parallel_client_initialization/threads", threads_);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    deferred_.clear();
+    deferring_ = threads_ > 0;
+
+    if (deferring_)
+    {
+        ROS_INFO_STREAM("[ClientInitializer] parallel client initialization with " << threads_ << " threads (ros param ~parallel_client_initialization/threads)");
+    }
+}
+
+bool ClientInitializer::defer(ISmaccClient *client, const std::type_info &clientType, std::function<void()> initialize)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!deferring_ || client->isSerialInitialization())
+        return false;
+
+    deferred_.push_back(DeferredClient{client, &clientType, initialize, {}, false, false});
+    return true;
+}
+
+void ClientInitializer::resolveDependencies()
+{
+    for (auto &entry : deferred_)
+    {
+        for (auto *dependencyType : entry.client->getInitializeAfter())
+        {
+            // dependencies that are not deferred are already initialized
+            for (int i = 0; i < (int)deferred_.size(); i++)
+            {
+                if (*deferred_[i].clientType == *dependencyType && deferred_[i].client != entry.client)
+                    entry.dependencies.push_back(i);
+            }
+        }
+    }
+}
+
+int ClientInitializer::nextReadyClient()
+{
+    for (int i = 0; i < (int)deferred_.size(); i++)
+    {
+        auto &entry = deferred_[i];
+        if (entry.started)
+            continue;
+
+        bool ready = true;
+        for (auto dependency : entry.dependencies)
+            ready = ready && deferred_[dependency].done;
+
+        if (ready)
+            return i;
+    }
+
+    return -1;
+}
+
+bool ClientInitializer::allDone()
+{
+    for (auto &entry : deferred_)
+    {
+        if (!entry.done)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+******************************************************************************************************************
+* run()
+******************************************************************************************************************
+*/
+void ClientInitializer::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    deferring_ = false;
+    if (deferred_.empty())
+        return;
+
+    ROS_INFO_STREAM("[ClientInitializer] initializing " << deferred_.size() << " clients");
+    this->resolveDependencies();
+
+    std::condition_variable condition;
+    std::exception_ptr error;
+    int running = 0;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            int index = this->nextReadyClient();
+            if (index < 0)
+            {
+                if (allDone())
+                    break;
+
+                if (running == 0)
+                {
+                    // nothing running and nothing ready: the remaining clients have a circular dependency
+                    index = std::find_if(deferred_.begin(), deferred_.end(), [](auto &entry) { return !entry.started; }) - deferred_.begin();
+                    ROS_ERROR_STREAM("[ClientInitializer] circular initialization dependency in " << deferred_[index].client->getName()
+                                                                                               << ". Initializing it anyway");
+                }
+                else
+                {
+                    condition.wait(lock);
+                    continue;
+                }
+            }
+
+            auto &entry = deferred_[index];
+            entry.started = true;
+            running++;
+
+            lock.unlock();
+            try
+            {
+                entry.initialize();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> errorLock(mutex_);
+                if (!error)
+                    error = std::current_exception();
+            }
+            lock.lock();
+
+            entry.done = true;
+            running--;
+            condition.notify_all();
+        }
+    };
+
+    lock.unlock();
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < std::min<int>(threads_, deferred_.size()); i++)
+        pool.push_back(std::thread(worker));
+
+    for (auto &thread : pool)
+        thread.join();
+
+    lock.lock();
+    deferred_.clear();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+} // namespace smacc
@@ -13,7 +13,7 @@ ISmaccComponent::~ISmaccComponent()
 }
 
 ISmaccComponent::ISmaccComponent()
-    : owner_(nullptr)
+    : stateMachine_(nullptr), owner_(nullptr)
 {
 }
 
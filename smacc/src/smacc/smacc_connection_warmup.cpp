@@ -0,0 +1,127 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_connection_warmup.h>
+#include <smacc/smacc_client.h>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace smacc
+{
+/**
+******************************************************************************************************************
+* waitForConnections()
+******************************************************************************************************************
+*/
+std::vector<ConnectionWarmup::ClientConnection> ConnectionWarmup::waitForConnections(const std::vector<std::shared_ptr<ISmaccClient>> &clients)
+{
+    std::vector<ClientConnection> report;
+
+    ros::NodeHandle nh("~");
+    double timeout = 5.0;
+    std::vector<std::string> ignored;
+    nh.getParam("connection_warmup/timeout", timeout);
+    nh.getParam("connection_warmup/ignore", ignored);
+
+    if (timeout <= 0)
+    {
+        ROS_INFO("[ConnectionWarmup] disabled (ros param ~connection_warmup/timeout)");
+        return report;
+    }
+
+    std::vector<ISmaccClient *> waited;
+    for (auto &client : clients)
+    {
+        if (!client->requiresConnection())
+            continue;
+
+        auto clientName = client->getShortTypeName();
+        if (clientName.empty())
+            clientName = smacc::utils::cleanShortTypeName(typeid(*client)); // not created by an orthogonal
+        if (std::find(ignored.begin(), ignored.end(), clientName) != ignored.end())
+        {
+            ROS_INFO_STREAM("[ConnectionWarmup] not waiting for " << clientName << " (ros param ~connection_warmup/ignore)");
+            continue;
+        }
+
+        waited.push_back(client.get());
+        report.push_back(ClientConnection{clientName, false, ros::WallDuration(0)});
+    }
+
+    if (waited.empty())
+        return report;
+
+    ROS_INFO_STREAM("[ConnectionWarmup] waiting up to " << timeout << "s for the connections of " << waited.size() << " clients");
+
+    // a thread per client: some checks block (ie: a service lookup), and they must not delay the others
+    auto start = ros::WallTime::now();
+    auto deadline = start + ros::WallDuration(timeout);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < waited.size(); i++)
+    {
+        threads.push_back(std::thread([&, i]() {
+            auto *client = waited[i];
+            auto &status = report[i];
+            while (ros::ok())
+            {
+                if (client->isConnected())
+                {
+                    status.connected = true;
+                    status.latency = ros::WallTime::now() - start;
+                    break;
+                }
+
+                if (ros::WallTime::now() >= deadline)
+                {
+                    status.latency = ros::WallTime::now() - start;
+                    break;
+                }
+
+                ros::WallDuration(0.01).sleep();
+            }
+        }));
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    return report;
+}
+
+/**
+******************************************************************************************************************
+* printReport()
+******************************************************************************************************************
+*/
+void ConnectionWarmup::printReport(const std::vector<ClientConnection> &report)
+{
+    if (report.empty())
+        return;
+
+    std::stringstream ss;
+    ss << "[ConnectionWarmup] client connections:" << std::endl;
+    int timedOut = 0;
+    for (auto &status : report)
+    {
+        ss << " - " << std::left << std::setw(40) << status.clientName << (status.connected ? "connected " : "TIMEOUT   ")
+           << std::right << std::setw(10) << std::fixed << std::setprecision(1) << status.latency.toSec() * 1000.0 << " ms" << std::endl;
+
+        if (!status.connected)
+            timedOut++;
+    }
+
+    if (timedOut > 0)
+    {
+        ss << timedOut << " clients not connected. The state machine starts anyway";
+        ROS_WARN_STREAM(ss.str());
+    }
+    else
+    {
+        ROS_INFO_STREAM(ss.str());
+    }
+}
+} // namespace smacc
@@ -0,0 +1,305 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_logging.h>
+#include <smacc/introspection/introspection.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace smacc
+{
+namespace logging
+{
+// capacity of the log ring (power of two)
+const size_t LOG_RING_CAPACITY = 4096;
+
+// Bounded multi-producer/single-consumer ring of log records. Every cell has a sequence number
+// that tells producers and the consumer whether the cell is free, being written or ready.
+//
+// The ring is never destroyed (no join or rosconsole call during the static destruction), shutdown() stops it.
+// After that, the records are written synchronously by the thread that logs them.
+class LogRing
+{
+public:
+    LogRing()
+        : cells_(LOG_RING_CAPACITY), enqueuePos_(0), dequeuePos_(0), dropped_(0), end_(false)
+    {
+        for (size_t i = 0; i < cells_.size(); i++)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+
+        consumerThread_ = std::thread(&LogRing::consumerLoop, this);
+    }
+
+    void shutdown()
+    {
+        std::lock_guard<std::mutex> lock(shutdownMutex_);
+        if (end_)
+            return;
+
+        end_ = true;
+        consumerThread_.join();
+    }
+
+    LogRecord *acquire(const LogSite *site)
+    {
+        if (end_)
+        {
+            static thread_local LogRecord syncRecord;
+            syncRecord.site = site;
+            return &syncRecord;
+        }
+
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell = cells_[pos & (LOG_RING_CAPACITY - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.record.site = site;
+                    return &cell.record;
+                }
+            }
+            else if (diff < 0)
+            {
+                // ring full, the background thread is not keeping up
+                dropped_++;
+                return nullptr;
+            }
+            else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void commit(LogRecord *record)
+    {
+        if (end_)
+        {
+            // the lock waits for the consumer thread to finish and serializes the synchronous output
+            std::lock_guard<std::mutex> lock(shutdownMutex_);
+            output(*record);
+            return;
+        }
+
+        Cell *cell = reinterpret_cast<Cell *>(reinterpret_cast<char *>(record) - offsetof(Cell, record));
+        size_t pos = cell->sequence.load(std::memory_order_relaxed);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    void flush()
+    {
+        if (end_)
+            return;
+
+        size_t target = enqueuePos_.load(std::memory_order_acquire);
+        while (dequeuePos_.load(std::memory_order_acquire) < target)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    unsigned long getDropped() const
+    {
+        return dropped_;
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::vector<Cell> cells_;
+    std::atomic<size_t> enqueuePos_;
+    std::atomic<size_t> dequeuePos_;
+    std::atomic<unsigned long> dropped_;
+    std::atomic<bool> end_;
+    std::thread consumerThread_;
+    std::mutex shutdownMutex_;
+
+    bool consumeOne()
+    {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell &cell = cells_[pos & (LOG_RING_CAPACITY - 1)];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if ((intptr_t)seq - (intptr_t)(pos + 1) < 0)
+            return false;
+
+        output(cell.record);
+
+        cell.sequence.store(pos + LOG_RING_CAPACITY, std::memory_order_release);
+        dequeuePos_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    void consumerLoop()
+    {
+        unsigned long reportedDrops = 0;
+        while (!end_)
+        {
+            bool any = false;
+            while (consumeOne())
+                any = true;
+
+            unsigned long drops = dropped_;
+            if (drops != reportedDrops)
+            {
+                ROS_WARN("[SMACC logging] %lu log messages dropped (log ring full)", drops - reportedDrops);
+                reportedDrops = drops;
+            }
+
+            if (!any)
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        while (consumeOne())
+            ;
+    }
+
+    void output(const LogRecord &record)
+    {
+        // the logger level was checked when the record was enqueued. The message keeps the location of the log call
+        auto site = record.site;
+        auto msg = formatLogRecord(record);
+        ros::console::print(nullptr, site->location->logger_, toRosconsoleLevel(site->level), site->file, site->line,
+                            site->function, "%s", msg.c_str());
+    }
+};
+
+static LogRing &getLogRing()
+{
+    static LogRing *ring = new LogRing();
+    return *ring;
+}
+
+LogRecord *acquireLogRecord(const LogSite *site)
+{
+    return getLogRing().acquire(site);
+}
+
+void commitLogRecord(LogRecord *record)
+{
+    getLogRing().commit(record);
+}
+
+unsigned long getDroppedLogCount()
+{
+    return getLogRing().getDropped();
+}
+
+void flushLog()
+{
+    getLogRing().flush();
+}
+
+void shutdownLog()
+{
+    getLogRing().shutdown();
+}
+
+std::string formatLogRecord(const LogRecord &record)
+{
+    // only accessed from the formatting thread (or under the shutdown lock, after the shutdown)
+    static std::map<const char *, std::string> demangledNames;
+
+    std::stringstream ss;
+    const char *fmt = record.site->format;
+    size_t offset = 0;
+
+    auto writeNextArg = [&]() {
+        if (offset >= record.size)
+        {
+            ss << "{?}";
+            return;
+        }
+
+        auto type = (LogArgType)record.payload[offset];
+        const char *data = record.payload + offset + 1;
+        switch (type)
+        {
+        case LogArgType::INT:
+        {
+            int64_t v;
+            memcpy(&v, data, sizeof(v));
+            ss << v;
+            offset += 1 + sizeof(v);
+            break;
+        }
+        case LogArgType::UINT:
+        {
+            uint64_t v;
+            memcpy(&v, data, sizeof(v));
+            ss << v;
+            offset += 1 + sizeof(v);
+            break;
+        }
+        case LogArgType::DOUBLE:
+        {
+            double v;
+            memcpy(&v, data, sizeof(v));
+            ss << v;
+            offset += 1 + sizeof(v);
+            break;
+        }
+        case LogArgType::BOOL:
+        {
+            bool v;
+            memcpy(&v, data, sizeof(v));
+            ss << (v ? "true" : "false");
+            offset += 1 + sizeof(v);
+            break;
+        }
+        case LogArgType::STRING:
+        {
+            uint16_t len;
+            memcpy(&len, data, sizeof(len));
+            ss.write(data + sizeof(len), len);
+            offset += 1 + sizeof(len) + len;
+            break;
+        }
+        case LogArgType::TYPE:
+        {
+            const char *name;
+            memcpy(&name, data, sizeof(name));
+            auto it = demangledNames.find(name);
+            if (it == demangledNames.end())
+                it = demangledNames.insert(std::make_pair(name, demangleSymbol(name))).first;
+            ss << it->second;
+            offset += 1 + sizeof(name);
+            break;
+        }
+        }
+    };
+
+    for (const char *c = fmt; *c != '\0'; c++)
+    {
+        if (c[0] == '{' && c[1] == '}')
+        {
+            writeNextArg();
+            c++;
+        }
+        else
+        {
+            ss << *c;
+        }
+    }
+
+    if (record.truncated)
+        ss << " [truncated]";
+
+    return ss.str();
+}
+} // namespace logging
+} // namespace smacc
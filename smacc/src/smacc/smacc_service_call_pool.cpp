@@ -0,0 +1,148 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_service_call_pool.h>
+#include <smacc/smacc_tracing.h>
+#include <algorithm>
+#include <thread>
+
+namespace smacc
+{
+ServiceCallPool::ServiceCallPool(int workers)
+    : workers_(std::max(1, workers)), state_(std::make_shared<State>()), started_(false)
+{
+}
+
+ServiceCallPool::~ServiceCallPool()
+{
+    std::map<CallId, TimerWheel::TimerId> pending;
+    {
+        std::unique_lock<std::mutex> lock(state_->doneMutex);
+        state_->alive = false;
+        pending.swap(state_->pending);
+
+        auto self = std::this_thread::get_id();
+        state_->doneCondition.wait(lock, [&] {
+            auto &running = state_->runningCallbacks;
+            return std::all_of(running.begin(), running.end(), [&](std::thread::id id) { return id == self; });
+        });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state_->queueMutex);
+        state_->stop = true;
+        state_->jobs.clear();
+    }
+    state_->queueCondition.notify_all();
+
+    for (auto &entry : pending)
+    {
+        if (entry.second != 0)
+            TimerWheel::getInstance().cancel(entry.second);
+    }
+}
+
+void ServiceCallPool::workerLoop(std::shared_ptr<State> state)
+{
+    smacc::tracing::setTraceThreadName("service_call_pool");
+
+    // persistent connections of this worker
+    Connections connections;
+
+    while (true)
+    {
+        std::function<void(Connections &)> job;
+        {
+            std::unique_lock<std::mutex> lock(state->queueMutex);
+            state->queueCondition.wait(lock, [&] { return state->stop || !state->jobs.empty(); });
+            if (state->stop)
+                return;
+
+            job = std::move(state->jobs.front());
+            state->jobs.pop_front();
+        }
+
+        job(connections);
+    }
+}
+
+bool ServiceCallPool::isPending(State &state, CallId callId)
+{
+    std::lock_guard<std::mutex> lock(state.doneMutex);
+    return state.alive && state.pending.count(callId);
+}
+
+void ServiceCallPool::complete(State &state, CallId callId, std::function<void()> done)
+{
+    TimerWheel::TimerId timeoutTimer = 0;
+    auto self = std::this_thread::get_id();
+    {
+        std::lock_guard<std::mutex> lock(state.doneMutex);
+        auto it = state.pending.find(callId);
+        if (!state.alive || it == state.pending.end())
+            return; // already completed (ie: response after the timeout) or discarded
+
+        timeoutTimer = it->second;
+        state.pending.erase(it);
+        state.runningCallbacks.push_back(self);
+    }
+
+    if (timeoutTimer != 0)
+        TimerWheel::getInstance().cancel(timeoutTimer);
+
+    try
+    {
+        done();
+    }
+    catch (...)
+    {
+        ROS_ERROR("[ServiceCallPool] exception in a service call done callback");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state.doneMutex);
+        auto &running = state.runningCallbacks;
+        running.erase(std::find(running.begin(), running.end(), self));
+    }
+    state.doneCondition.notify_all();
+}
+
+ServiceCallPool::CallId ServiceCallPool::registerCall(ros::Duration timeout, std::function<void(CallId)> onTimeout)
+{
+    std::lock_guard<std::mutex> lock(state_->doneMutex);
+    CallId callId = state_->nextCallId++;
+    auto &timer = state_->pending[callId];
+    timer = 0;
+
+    // the timer callback locks doneMutex, so it finds the entry already registered
+    if (!timeout.isZero())
+    {
+        timer = TimerWheel::getInstance().schedule(timeout, [onTimeout, callId]() { onTimeout(callId); });
+    }
+
+    return callId;
+}
+
+void ServiceCallPool::enqueue(std::function<void(Connections &)> job)
+{
+    bool start;
+    {
+        std::lock_guard<std::mutex> lock(state_->queueMutex);
+        state_->jobs.push_back(job);
+        start = !started_;
+        started_ = true;
+    }
+    state_->queueCondition.notify_one();
+
+    if (start)
+    {
+        for (int i = 0; i < workers_; i++)
+        {
+            // the workers only use the shared state, a call blocked in a worker does not block the destructor
+            std::thread(&ServiceCallPool::workerLoop, state_).detach();
+        }
+    }
+}
+} // namespace smacc
@@ -0,0 +1,162 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_startup_profiler.h>
+#include <smacc/smacc_tracing.h>
+#include <ros/ros.h>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace smacc
+{
+namespace
+{
+// nesting level of the steps of the calling thread
+thread_local int currentDepth_ = 0;
+
+// bytes of heap in use by the process
+int64_t heapInUse()
+{
+#ifdef __GLIBC__
+#if __GLIBC_PREREQ(2, 33)
+    struct mallinfo2 info = mallinfo2();
+    return (int64_t)info.uordblks + (int64_t)info.hblkhd;
+#else
+    struct mallinfo info = mallinfo();
+    return (int64_t)(unsigned int)info.uordblks + (int64_t)(unsigned int)info.hblkhd;
+#endif
+#else
+    return 0;
+#endif
+}
+} // namespace
+
+StartupProfiler &StartupProfiler::getInstance()
+{
+    static StartupProfiler instance;
+    return instance;
+}
+
+StartupProfiler::StartupProfiler()
+    : running_(false), startNs_(0), stopNs_(0)
+{
+}
+
+/**
+******************************************************************************************************************
+* start()
+******************************************************************************************************************
+*/
+void StartupProfiler::start()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    phases_.clear();
+    startNs_ = smacc::tracing::traceNow();
+    stopNs_ = startNs_;
+    running_ = true;
+}
+
+void StartupProfiler::stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopNs_ = smacc::tracing::traceNow();
+    running_ = false;
+}
+
+int StartupProfiler::beginStep(const char *category, const std::string &name, int depth)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_)
+        return -1;
+
+    smacc_msgs::SmaccStartupPhase phase;
+    phase.category = category;
+    phase.name = name;
+    phase.depth = depth;
+    phases_.push_back(phase);
+    return phases_.size() - 1;
+}
+
+void StartupProfiler::endStep(int index, uint64_t durationNs, int64_t heapBytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (index >= (int)phases_.size())
+        return; // restarted meanwhile
+
+    phases_[index].duration = durationNs * 1e-9;
+    phases_[index].heap_bytes = heapBytes;
+}
+
+/**
+******************************************************************************************************************
+* Scope
+******************************************************************************************************************
+*/
+StartupProfiler::Scope::Scope(const char *category, const std::string &name)
+    : index_(-1)
+{
+    auto &profiler = StartupProfiler::getInstance();
+    if (!profiler.isRunning())
+        return;
+
+    index_ = profiler.beginStep(category, name, currentDepth_);
+    if (index_ >= 0)
+    {
+        currentDepth_++;
+        startHeap_ = heapInUse();
+        startNs_ = smacc::tracing::traceNow();
+    }
+}
+
+StartupProfiler::Scope::~Scope()
+{
+    if (index_ < 0)
+        return;
+
+    auto durationNs = smacc::tracing::traceNow() - startNs_;
+    auto heapBytes = heapInUse() - startHeap_;
+    currentDepth_--;
+
+    StartupProfiler::getInstance().endStep(index_, durationNs, heapBytes);
+}
+
+/**
+******************************************************************************************************************
+* getReport()
+******************************************************************************************************************
+*/
+smacc_msgs::SmaccStartupReport StartupProfiler::getReport()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    smacc_msgs::SmaccStartupReport report;
+    report.header.stamp = ros::Time::now();
+    report.total_duration = ((running_ ? smacc::tracing::traceNow() : stopNs_) - startNs_) * 1e-9;
+    report.phases = phases_;
+    return report;
+}
+
+void StartupProfiler::printReport()
+{
+    auto report = this->getReport();
+
+    std::stringstream ss;
+    ss << "[StartupProfiler] state machine startup: " << std::fixed << std::setprecision(1) << report.total_duration * 1000.0 << " ms" << std::endl;
+    ss << std::left << std::setw(70) << "   step" << std::setw(20) << "category" << std::right << std::setw(12) << "ms" << std::setw(14) << "heap KB" << std::endl;
+
+    for (auto &phase : report.phases)
+    {
+        auto label = std::string(3 + 2 * phase.depth, ' ') + phase.name;
+        ss << std::left << std::setw(70) << label << std::setw(20) << phase.category
+           << std::right << std::setw(12) << std::setprecision(1) << phase.duration * 1000.0
+           << std::setw(14) << std::setprecision(1) << phase.heap_bytes / 1024.0 << std::endl;
+    }
+
+    ROS_INFO_STREAM(ss.str());
+}
+} // namespace smacc
@@ -10,7 +10,7 @@ std::string ISmaccState::getClassName()
 
 void ISmaccState::notifyTransitionFromTransitionTypeInfo(TypeInfo::Ptr &transitionType)
 {
-    ROS_INFO_STREAM("NOTIFY TRANSITION: " << transitionType->getFullName());
+    SMACC_LOG_INFO("NOTIFY TRANSITION: {}", transitionType->getFullName());
 
     //auto currstateinfo = this->getStateMachine().getCurrentStateInfo();
     auto currstateinfo = this->stateInfo_;
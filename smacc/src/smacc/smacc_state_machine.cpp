@@ -6,6 +6,8 @@
 #include <smacc/smacc_state_machine.h>
 #include <smacc/smacc_signal_detector.h>
 #include <smacc/smacc_orthogonal.h>
+#include <smacc/smacc_connection_warmup.h>
+#include <smacc/smacc_startup_profiler.h>
 #include <smacc/client_bases/smacc_action_client.h>
 #include <smacc_msgs/SmaccStatus.h>
 #include <smacc_msgs/SmaccTransitionLogEntry.h>
@@ -13,7 +15,7 @@ namespace smacc
 {
 using namespace smacc::introspection;
 ISmaccStateMachine::ISmaccStateMachine(SignalDetector *signalDetector)
-    : private_nh_("~"), currentState_(nullptr), stateSeqCounter_(0)
+    : private_nh_("~"), currentState_(nullptr), stateSeqCounter_(0), delayedEventsCounter_(0)
 {
     ROS_INFO("Creating State Machine Base");
     signalDetector_ = signalDetector;
@@ -39,11 +41,30 @@ ISmaccStateMachine::ISmaccStateMachine(SignalDetector *signalDetector)
     {
         runMode_ = SMRunMode::DEBUG;
     }
+
+    bool tracingEnabled;
+    if (nh_.getParam("tracing_enabled", tracingEnabled))
+    {
+        ROS_INFO("State machine execution tracing (ros param tracing_enabled): %d", tracingEnabled);
+        smacc::tracing::setTracingEnabled(tracingEnabled);
+    }
 }
 
 ISmaccStateMachine::~ISmaccStateMachine()
 {
     ROS_INFO("Finishing State Machine");
+
+    std::map<unsigned long, TimerWheel::TimerId> delayedEvents;
+    {
+        std::lock_guard<std::mutex> lock(delayedEventsMutex_);
+        delayedEvents.swap(delayedEvents_);
+    }
+
+    // it waits for the delayed events being posted right now
+    for (auto &entry : delayedEvents)
+        TimerWheel::getInstance().cancel(entry.second);
+
+    smacc::logging::flushLog();
 }
 
 void ISmaccStateMachine::reset()
@@ -58,6 +79,11 @@ void ISmaccStateMachine::eStop()
 {
 }
 
+void ISmaccStateMachine::postContinuation(std::function<void()> continuation)
+{
+    signalDetector_->postContinuation(continuation);
+}
+
 const std::map<std::string, std::shared_ptr<smacc::ISmaccOrthogonal>> &ISmaccStateMachine::getOrthogonals() const
 {
     return this->orthogonals_;
@@ -69,8 +95,7 @@ void ISmaccStateMachine::updateStatusMessage()
 
     if (currentStateInfo_ != nullptr)
     {
-        ROS_WARN_STREAM("[StateMachine] setting state active "
-                        << ": " << currentStateInfo_->getFullPath());
+        SMACC_LOG_WARN("[StateMachine] setting state active : {}", currentStateInfo_->getFullPath());
 
         if (this->runMode_ == SMRunMode::DEBUG)
         {
@@ -117,6 +142,26 @@ void ISmaccStateMachine::onInitialized()
     timer_ = nh_.createTimer(ros::Duration(0.5), &ISmaccStateMachine::state_machine_visualization, this);
 }
 
+void ISmaccStateMachine::waitForConnections()
+{
+    std::vector<std::shared_ptr<smacc::ISmaccClient>> clients;
+    for (auto &orthogonal : orthogonals_)
+    {
+        auto &orthogonalClients = orthogonal.second->getClients();
+        clients.insert(clients.end(), orthogonalClients.begin(), orthogonalClients.end());
+    }
+
+    auto report = ConnectionWarmup::waitForConnections(clients);
+    ConnectionWarmup::printReport(report);
+}
+
+void ISmaccStateMachine::publishStartupReport()
+{
+    auto &profiler = StartupProfiler::getInstance();
+    profiler.printReport();
+    startupReportPub_.publish(profiler.getReport());
+}
+
 void ISmaccStateMachine::onInitializing(std::string shortname)
 {
     ROS_WARN_STREAM("State machine base creation:" << shortname);
@@ -124,9 +169,11 @@ void ISmaccStateMachine::onInitializing(std::string shortname)
     stateMachinePub_ = nh_.advertise<smacc_msgs::SmaccStateMachine>(shortname + "/smacc/state_machine_description", 1);
     stateMachineStatusPub_ = nh_.advertise<smacc_msgs::SmaccStatus>(shortname + "/smacc/status", 1);
     transitionLogPub_ = nh_.advertise<smacc_msgs::SmaccTransitionLogEntry>(shortname + "/smacc/transition_log", 1);
+    startupReportPub_ = nh_.advertise<smacc_msgs::SmaccStartupReport>(shortname + "/smacc/startup_report", 1, true /*latched*/);
 
     // STATE MACHINE SERVICES
     transitionHistoryService_ = nh_.advertiseService(shortname + "/smacc/transition_log_history", &ISmaccStateMachine::getTransitionLogHistory, this);
+    dumpTraceService_ = nh_.advertiseService(shortname + "/smacc/dump_trace", &ISmaccStateMachine::dumpTrace, this);
 
     this->onInitialize();
 }
@@ -138,6 +185,30 @@ bool ISmaccStateMachine::getTransitionLogHistory(smacc_msgs::SmaccGetTransitionH
     return true;
 }
 
+bool ISmaccStateMachine::dumpTrace(smacc_msgs::SmaccDumpTrace::Request &req, smacc_msgs::SmaccDumpTrace::Response &res)
+{
+    if (!smacc::tracing::isTracingEnabled())
+    {
+        ROS_WARN("Dumping execution trace but tracing is disabled (ros param tracing_enabled). The trace may be empty.");
+    }
+
+    std::string errorMessage;
+    res.success = smacc::tracing::dumpChromeTrace(req.output_file, errorMessage);
+    if (res.success)
+    {
+        res.message = "trace written to " + req.output_file;
+        if (req.clear)
+            smacc::tracing::clearTrace();
+    }
+    else
+    {
+        res.message = errorMessage;
+    }
+
+    ROS_INFO("Dump execution trace: %s", res.message.c_str());
+    return true;
+}
+
 void ISmaccStateMachine::state_machine_visualization(const ros::TimerEvent &)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex_);
@@ -0,0 +1,410 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_timer_wheel.h>
+#include <smacc/smacc_tracing.h>
+#include <ros/ros.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace smacc
+{
+/**
+******************************************************************************************************************
+* getInstance()
+******************************************************************************************************************
+*/
+TimerWheel &TimerWheel::getInstance()
+{
+    // intentionally never destroyed: the wheel thread must not be joined during static destruction
+    static TimerWheel *instance = new TimerWheel();
+    return *instance;
+}
+
+TimerWheel::TimerWheel()
+    : now_(0), nextId_(1), executingTimer_(0), shutdown_(false)
+{
+    ros::param::param<double>("~timer_wheel_resolution", resolution_, 0.001);
+    origin_ = ros::Time::now();
+
+    thread_ = std::thread(&TimerWheel::run, this);
+}
+
+TimerWheel::~TimerWheel()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    condition_.notify_all();
+
+    if (thread_.joinable())
+        thread_.join();
+}
+
+uint64_t TimerWheel::currentTick() const
+{
+    uint64_t now = now_.load(std::memory_order_relaxed);
+    double ellapsed = (ros::Time::now() - origin_).toSec();
+    if (ellapsed > 0)
+        now = std::max<uint64_t>(now, (uint64_t)(ellapsed / resolution_));
+
+    return now;
+}
+
+uint64_t TimerWheel::toTicks(ros::Duration duration) const
+{
+    return std::max<uint64_t>(1, (uint64_t)std::ceil(duration.toSec() / resolution_));
+}
+
+/**
+******************************************************************************************************************
+* schedule()
+******************************************************************************************************************
+*/
+TimerWheel::TimerId TimerWheel::schedule(ros::Duration delay, std::function<void()> callback, ros::Duration period)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // the wheel does not tick while it is empty, it is brought to the current time before the insertion
+    if (timers_.empty())
+    {
+        double ellapsed = (ros::Time::now() - origin_).toSec();
+        if (ellapsed > 0)
+            now_ = std::max<uint64_t>(now_, (uint64_t)(ellapsed / resolution_));
+    }
+
+    TimerId id = nextId_++;
+    auto &timer = timers_[id];
+    // relative to the current time, the wheel may be behind it while its thread sleeps
+    timer.expiry = this->currentTick() + toTicks(delay);
+    timer.period = period.isZero() ? 0 : toTicks(period);
+    timer.callback = callback;
+    insert(id, timer.expiry);
+
+    condition_.notify_all();
+    return id;
+}
+
+/**
+******************************************************************************************************************
+* cancel()
+******************************************************************************************************************
+*/
+void TimerWheel::cancel(TimerId timer)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // the slot entry is discarded lazily when its slot expires
+    timers_.erase(timer);
+
+    if (std::this_thread::get_id() != thread_.get_id())
+    {
+        callbackDone_.wait(lock, [&] { return executingTimer_ != timer; });
+    }
+}
+
+/**
+******************************************************************************************************************
+* insert()
+******************************************************************************************************************
+*/
+void TimerWheel::insert(TimerId id, uint64_t expiry)
+{
+    uint64_t now = now_;
+    uint64_t delta = expiry > now ? expiry - now : 0;
+
+    if (delta < ((uint64_t)1 << SLOT_BITS))
+    {
+        // overdue timers (ie: periodic timers after a time jump) expire in the next tick
+        uint64_t slotTime = delta == 0 ? now + 1 : expiry;
+        slots_[0][slotTime & (SLOTS - 1)].push_back(id);
+        return;
+    }
+
+    for (int level = 1; level < LEVELS; level++)
+    {
+        if (delta < ((uint64_t)1 << (SLOT_BITS * (level + 1))) || level == LEVELS - 1)
+        {
+            // timers beyond the wheel range are parked in the furthest slot and inserted again when cascaded
+            uint64_t maxDelta = ((uint64_t)1 << (SLOT_BITS * LEVELS)) - 1;
+            uint64_t slotTime = delta <= maxDelta ? expiry : now + maxDelta;
+            slots_[level][(slotTime >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(id);
+            return;
+        }
+    }
+}
+
+/**
+******************************************************************************************************************
+* cascade()
+******************************************************************************************************************
+*/
+void TimerWheel::cascade(int level)
+{
+    std::vector<TimerId> entries;
+    entries.swap(slots_[level][(now_ >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+
+    for (auto id : entries)
+    {
+        auto it = timers_.find(id);
+        if (it != timers_.end())
+            insert(id, it->second.expiry);
+    }
+}
+
+/**
+******************************************************************************************************************
+* tick()
+******************************************************************************************************************
+*/
+void TimerWheel::tick(uint64_t target, std::vector<std::pair<TimerId, std::function<void()>>> &expired)
+{
+    uint64_t now = ++now_;
+
+    // every time a level wraps, the current slot of the next level is distributed in the lower levels
+    if ((now & (SLOTS - 1)) == 0)
+    {
+        for (int level = 1; level < LEVELS; level++)
+        {
+            cascade(level);
+            if (((now >> (SLOT_BITS * level)) & (SLOTS - 1)) != 0)
+                break;
+        }
+    }
+
+    std::vector<TimerId> entries;
+    entries.swap(slots_[0][now & (SLOTS - 1)]);
+
+    for (auto id : entries)
+    {
+        auto it = timers_.find(id);
+        if (it == timers_.end())
+            continue;
+
+        auto &timer = it->second;
+        if (timer.expiry > now)
+        {
+            insert(id, timer.expiry);
+            continue;
+        }
+
+        expired.push_back(std::make_pair(id, timer.callback));
+
+        if (timer.period > 0)
+        {
+            timer.expiry += timer.period;
+
+            // if the wheel is behind the current time (ie: ros::Time jumped forward) the missed periods are
+            // skipped, not expired one by one
+            if (timer.expiry <= target)
+                timer.expiry = target + timer.period;
+
+            insert(id, timer.expiry);
+        }
+        else
+        {
+            // one shot timers stay registered until their callback is called, so they can still be cancelled
+            timer.expiry = std::numeric_limits<uint64_t>::max();
+        }
+    }
+}
+
+/**
+******************************************************************************************************************
+* nextEventTick()
+******************************************************************************************************************
+*/
+uint64_t TimerWheel::nextEventTick() const
+{
+    uint64_t now = now_;
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+
+    // level 0 slots hold the timers of the next SLOTS ticks
+    for (uint64_t t = now + 1; t <= now + SLOTS; t++)
+    {
+        if (!slots_[0][t & (SLOTS - 1)].empty())
+        {
+            next = t;
+            break;
+        }
+    }
+
+    // the slots of the upper levels are processed when they are cascaded, at the start of their period
+    for (int level = 1; level < LEVELS; level++)
+    {
+        int shift = SLOT_BITS * level;
+        for (uint64_t k = 1; k <= SLOTS; k++)
+        {
+            uint64_t t = ((now >> shift) + k) << shift;
+            if (t >= next)
+                break;
+
+            if (!slots_[level][(t >> shift) & (SLOTS - 1)].empty())
+            {
+                next = t;
+                break;
+            }
+        }
+    }
+
+    return next;
+}
+
+/**
+******************************************************************************************************************
+* run()
+******************************************************************************************************************
+*/
+void TimerWheel::run()
+{
+    smacc::tracing::setTraceThreadName("timer_wheel");
+
+    std::vector<std::pair<TimerId, std::function<void()>>> expired;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!shutdown_)
+    {
+        if (timers_.empty())
+        {
+            condition_.wait(lock, [this] { return shutdown_ || !timers_.empty(); });
+            continue;
+        }
+
+        double ellapsed = (ros::Time::now() - origin_).toSec();
+        uint64_t target = ellapsed > 0 ? (uint64_t)(ellapsed / resolution_) : 0;
+
+        while (now_ < target && !shutdown_)
+        {
+            // nothing expires nor cascades before the next event, so the wheel jumps there (in bulk when
+            // ros::Time jumps forward)
+            uint64_t next = this->nextEventTick();
+            if (next > target)
+            {
+                now_ = target;
+                break;
+            }
+
+            now_ = next - 1;
+            expired.clear();
+            this->tick(target, expired);
+
+            for (auto &entry : expired)
+            {
+                auto it = timers_.find(entry.first);
+                if (it == timers_.end())
+                    continue; // cancelled meanwhile
+
+                if (it->second.period == 0)
+                    timers_.erase(it);
+
+                executingTimer_ = entry.first;
+                lock.unlock();
+                try
+                {
+                    entry.second();
+                }
+                catch (const std::exception &e)
+                {
+                    ROS_ERROR("[TimerWheel] exception in timer callback: %s", e.what());
+                }
+                lock.lock();
+                executingTimer_ = 0;
+                callbackDone_.notify_all();
+            }
+        }
+
+        if (shutdown_ || timers_.empty())
+            continue;
+
+        // sleeps until the next event (or until a new timer is scheduled). The wait is in wall time: it is
+        // bounded because ros::Time may jump or, in simulation, run faster than the wall clock
+        double wait = ros::Time::isSimTime() ? 0.01 : 1.0;
+        uint64_t next = this->nextEventTick();
+        if (next != std::numeric_limits<uint64_t>::max())
+            wait = std::min(wait, (origin_ + ros::Duration(next * resolution_) - ros::Time::now()).toSec());
+
+        if (wait > 0)
+            condition_.wait_for(lock, std::chrono::duration<double>(wait));
+    }
+}
+
+/**
+******************************************************************************************************************
+* SmaccWatchdog
+******************************************************************************************************************
+*/
+SmaccWatchdog::SmaccWatchdog()
+    : timer_(0), timeoutTicks_(0), lastFeed_(0)
+{
+}
+
+SmaccWatchdog::~SmaccWatchdog()
+{
+    this->stop();
+}
+
+void SmaccWatchdog::start(ros::Duration timeout, std::function<void()> onTimeout)
+{
+    this->stop();
+
+    auto &wheel = TimerWheel::getInstance();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    timeoutTicks_ = wheel.toTicks(timeout);
+    onTimeout_ = onTimeout;
+    this->feed();
+    this->arm(lastFeed_ + timeoutTicks_);
+}
+
+void SmaccWatchdog::stop()
+{
+    TimerWheel::TimerId timer;
+    {
+        // waits for a check in progress, so it does not arm the timer again
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer = timer_;
+        timer_ = 0;
+    }
+
+    if (timer != 0)
+        TimerWheel::getInstance().cancel(timer);
+}
+
+void SmaccWatchdog::arm(uint64_t deadline)
+{
+    auto &wheel = TimerWheel::getInstance();
+    uint64_t now = wheel.currentTick();
+    uint64_t ticks = deadline > now ? deadline - now : 1;
+    timer_ = wheel.schedule(ros::Duration(ticks * wheel.getResolution().toSec()), [this]() { this->check(); });
+}
+
+void SmaccWatchdog::check()
+{
+    std::function<void()> onTimeout;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (timer_ == 0)
+            return; // stopped
+
+        uint64_t now = TimerWheel::getInstance().currentTick();
+        uint64_t deadline = lastFeed_.load(std::memory_order_relaxed) + timeoutTicks_;
+
+        if (deadline > now)
+        {
+            // fed meanwhile
+            this->arm(deadline);
+            return;
+        }
+
+        this->arm(now + timeoutTicks_);
+        onTimeout = onTimeout_;
+    }
+
+    // the callback usually posts an event (it takes the state machine lock), a thread holding that lock may be
+    // stopping the watchdog
+    onTimeout();
+}
+} // namespace smacc
@@ -0,0 +1,213 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_tracing.h>
+#include <smacc/introspection/introspection.h>
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+
+namespace smacc
+{
+namespace tracing
+{
+std::atomic<bool> tracingEnabled_(false);
+
+// Amount of records kept per thread. When the buffer is full the oldest records are overwritten.
+const size_t THREAD_BUFFER_CAPACITY = 1 << 16;
+
+struct ThreadTraceBuffer
+{
+    ThreadTraceBuffer(uint32_t tid)
+        : tid(tid), next(0), wrapped(false)
+    {
+        records.resize(THREAD_BUFFER_CAPACITY);
+    }
+
+    // only contended while the trace is being exported or cleared
+    std::mutex mutex;
+
+    uint32_t tid;
+    std::string threadName;
+
+    std::vector<TraceRecord> records;
+    size_t next;
+    bool wrapped;
+};
+
+// all the thread buffers ever created. They are kept alive after their thread finishes
+// so that the events of short lived threads still appear in the exported trace
+static std::mutex registryMutex_;
+static std::vector<std::shared_ptr<ThreadTraceBuffer>> registry_;
+static uint32_t tidCounter_ = 0;
+
+static ThreadTraceBuffer &getThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadTraceBuffer> buffer;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        buffer = std::make_shared<ThreadTraceBuffer>(++tidCounter_);
+        registry_.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+void setTracingEnabled(bool enabled)
+{
+    tracingEnabled_.store(enabled);
+}
+
+void traceRecord(const TraceRecord &record)
+{
+    auto &buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    buffer.records[buffer.next] = record;
+    buffer.next++;
+    if (buffer.next == buffer.records.size())
+    {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+void traceInstant(const char *category, const char *name, TraceNameKind nameKind)
+{
+    TraceRecord record;
+    record.category = category;
+    record.name = name;
+    record.nameKind = nameKind;
+    record.phase = 'i';
+    record.timestampNs = traceNow();
+    record.durationNs = 0;
+    traceRecord(record);
+}
+
+void setTraceThreadName(const char *name)
+{
+    auto &buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+void clearTrace()
+{
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    for (auto &buffer : registry_)
+    {
+        std::lock_guard<std::mutex> bufferlock(buffer->mutex);
+        buffer->next = 0;
+        buffer->wrapped = false;
+    }
+}
+
+static void writeJsonString(std::ostream &out, const std::string &str)
+{
+    out << '"';
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (c == '\n')
+            out << "\\n";
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+bool dumpChromeTrace(const std::string &filepath, std::string &errorMessage)
+{
+    std::ofstream out(filepath);
+    if (!out)
+    {
+        errorMessage = "could not open the output file: " + filepath;
+        return false;
+    }
+
+    // demangling is expensive, it is done once per type and only at export time
+    std::map<const char *, std::string> demangledNames;
+    auto pid = getpid();
+
+    // copy the records while holding the buffer lock, format them outside
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        buffers = registry_;
+    }
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+
+    for (auto &buffer : buffers)
+    {
+        std::vector<TraceRecord> records;
+        std::string threadName;
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            threadName = buffer->threadName;
+            if (buffer->wrapped)
+                records.insert(records.end(), buffer->records.begin() + buffer->next, buffer->records.end());
+            records.insert(records.end(), buffer->records.begin(), buffer->records.begin() + buffer->next);
+        }
+
+        if (!threadName.empty())
+        {
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+                << ",\"tid\":" << buffer->tid << ",\"args\":{\"name\":";
+            writeJsonString(out, threadName);
+            out << "}}";
+            first = false;
+        }
+
+        for (auto &record : records)
+        {
+            std::string name;
+            if (record.nameKind == TraceNameKind::MANGLED_TYPE)
+            {
+                auto it = demangledNames.find(record.name);
+                if (it == demangledNames.end())
+                    it = demangledNames.insert(std::make_pair(record.name, demangleSymbol(record.name))).first;
+                name = it->second;
+            }
+            else
+            {
+                name = record.name;
+            }
+
+            out << (first ? "" : ",") << "\n{\"name\":";
+            writeJsonString(out, name);
+            out << ",\"cat\":\"" << record.category << "\",\"ph\":\"" << record.phase << "\""
+                << ",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+                << ",\"ts\":" << (record.timestampNs / 1000) << "." << (record.timestampNs % 1000) / 100;
+
+            if (record.phase == 'X')
+                out << ",\"dur\":" << (record.durationNs / 1000) << "." << (record.durationNs % 1000) / 100;
+            else
+                out << ",\"s\":\"t\"";
+
+            out << "}";
+            first = false;
+        }
+    }
+
+    out << "\n]}\n";
+
+    if (!out)
+    {
+        errorMessage = "error writing the output file: " + filepath;
+        return false;
+    }
+
+    return true;
+}
+} // namespace tracing
+} // namespace smacc
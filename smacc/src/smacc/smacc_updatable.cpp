@@ -1,41 +1,157 @@
 #include <smacc/smacc_updatable.h>
+#include <smacc/introspection/introspection.h>
+#include <algorithm>
 
 namespace smacc
 {
+// amount of update executions used to compute the rolling statistics
+const size_t UPDATE_STATISTICS_WINDOW = 512;
 
 ISmaccUpdatable::ISmaccUpdatable()
-    : lastUpdate_(0)
+    : periodTimer_(0),
+      updateDue_(true),
+      nextSample_(0),
+      updateCount_(0),
+      overrunCount_(0),
+      reportedOverrunCount_(0),
+      budgetConfigured_(false)
 {
 }
 
 ISmaccUpdatable::ISmaccUpdatable(ros::Duration duration)
-    : lastUpdate_(0),
-      periodDuration_(duration)
+    : periodDuration_(duration),
+      periodTimer_(0),
+      updateDue_(true),
+      nextSample_(0),
+      updateCount_(0),
+      overrunCount_(0),
+      reportedOverrunCount_(0),
+      budgetConfigured_(false)
 {
 }
 
+ISmaccUpdatable::~ISmaccUpdatable()
+{
+    if (periodTimer_ != 0)
+        TimerWheel::getInstance().cancel(periodTimer_);
+}
+
 void ISmaccUpdatable::setUpdatePeriod(ros::Duration duration)
 {
+    if (periodTimer_ != 0)
+    {
+        // the timer is scheduled again with the new period in the next update
+        TimerWheel::getInstance().cancel(periodTimer_);
+        periodTimer_ = 0;
+    }
+
     periodDuration_ = duration;
 }
 
+void ISmaccUpdatable::setUpdateBudget(ros::Duration budget)
+{
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    budget_ = budget;
+    budgetConfigured_ = true;
+}
+
+boost::optional<ros::Duration> ISmaccUpdatable::getUpdateBudget()
+{
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    return budget_;
+}
+
 void ISmaccUpdatable::executeUpdate()
 {
     bool update = true;
     if (periodDuration_)
     {
-        auto now = ros::Time::now();
-        auto ellapsed = now - this->lastUpdate_;
-        update = ellapsed > *periodDuration_;
-        if(update)
+        if (periodTimer_ == 0)
         {
-            this->lastUpdate_ = now;
+            periodTimer_ = TimerWheel::getInstance().schedule(
+                *periodDuration_, [this]() { updateDue_.store(true, std::memory_order_relaxed); }, *periodDuration_);
         }
+
+        update = updateDue_.exchange(false, std::memory_order_relaxed);
     }
 
     if (update)
     {
+        auto start = std::chrono::steady_clock::now();
         this->update();
+        std::chrono::duration<double> ellapsed = std::chrono::steady_clock::now() - start;
+
+        this->registerUpdateDuration(ellapsed.count());
+    }
+}
+
+void ISmaccUpdatable::registerUpdateDuration(double ellapsedSeconds)
+{
+    bool warn = false;
+    double budgetSeconds = 0;
+    {
+        std::lock_guard<std::mutex> lock(statisticsMutex_);
+
+        if (samples_.size() < UPDATE_STATISTICS_WINDOW)
+        {
+            samples_.push_back(ellapsedSeconds);
+        }
+        else
+        {
+            samples_[nextSample_] = ellapsedSeconds;
+        }
+        nextSample_ = (nextSample_ + 1) % UPDATE_STATISTICS_WINDOW;
+        updateCount_++;
+
+        if (budget_ && ellapsedSeconds > budget_->toSec())
+        {
+            overrunCount_++;
+            budgetSeconds = budget_->toSec();
+
+            // throttled per object, so the overruns of one updatable do not hide the overruns of the others
+            auto now = std::chrono::steady_clock::now();
+            if (overrunCount_ == 1 || now - lastOverrunWarning_ >= std::chrono::seconds(1))
+            {
+                lastOverrunWarning_ = now;
+                warn = true;
+            }
+        }
     }
+
+    if (warn)
+    {
+        ROS_WARN_STREAM("[" << demangleSymbol(typeid(*this).name()) << "] update budget overrun: "
+                            << ellapsedSeconds * 1000.0 << " ms (budget " << budgetSeconds * 1000.0 << " ms)");
+    }
+}
+
+UpdateStatistics ISmaccUpdatable::getUpdateStatistics()
+{
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+
+    UpdateStatistics stats;
+    stats.budget = budget_;
+    stats.count = updateCount_;
+    stats.overruns = overrunCount_;
+
+    if (!samples_.empty())
+    {
+        size_t lastIndex = (nextSample_ + samples_.size() - 1) % samples_.size();
+        stats.last = ros::Duration(samples_[lastIndex]);
+
+        double sum = 0;
+        for (auto &s : samples_)
+            sum += s;
+        stats.mean = ros::Duration(sum / samples_.size());
+
+        // the statistics are queried at a low rate, so sorting a copy of the window is fine
+        std::vector<double> sorted = samples_;
+        size_t p99index = std::min(sorted.size() - 1, (size_t)(0.99 * sorted.size()));
+        std::nth_element(sorted.begin(), sorted.begin() + p99index, sorted.end());
+        stats.p99 = ros::Duration(sorted[p99index]);
+        stats.max = ros::Duration(*std::max_element(sorted.begin() + p99index, sorted.end()));
+    }
+
+    return stats;
+}
 }
-}
\ No newline at end of file
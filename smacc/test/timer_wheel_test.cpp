@@ -0,0 +1,182 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <smacc/smacc_timer_wheel.h>
+#include <ros/ros.h>
+#include <gtest/gtest.h>
+#include <chrono>
+
+using namespace smacc;
+
+// the wheel follows the simulated ros time, the tests only move it forward
+const double DAY = 3600 * 24;
+double simTime = 1000;
+
+void advance(double seconds)
+{
+  simTime += seconds;
+  ros::Time::setNow(ros::Time(simTime));
+}
+
+void sleepMs(int ms)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// waits up to 1 second (wall time) for the condition
+template <typename TCondition>
+bool waitFor(TCondition condition)
+{
+  for (int i = 0; i < 200 && !condition(); i++)
+    sleepMs(5);
+
+  return condition();
+}
+
+TEST(TimerWheelTest, cascadedTimerExpiresOnTime)
+{
+  auto &wheel = TimerWheel::getInstance();
+  std::atomic<int> fired(0);
+
+  // 300 ticks: the timer starts in level 1 and is cascaded to level 0
+  wheel.schedule(ros::Duration(0.3), [&] { fired++; });
+
+  advance(0.25);
+  sleepMs(50);
+  EXPECT_EQ(fired, 0);
+
+  advance(0.1);
+  EXPECT_TRUE(waitFor([&] { return fired == 1; }));
+}
+
+TEST(TimerWheelTest, forwardJumpSkipsTheMissedPeriods)
+{
+  auto &wheel = TimerWheel::getInstance();
+  std::atomic<int> fired(0), periodic(0);
+
+  wheel.schedule(ros::Duration(100.0), [&] { fired++; });
+  auto periodicTimer = wheel.schedule(ros::Duration(0.001), [&] { periodic++; }, ros::Duration(0.001));
+
+  // 10 days are 864 million ticks, the wheel must not replay them one by one
+  auto start = std::chrono::steady_clock::now();
+  advance(10 * DAY);
+  EXPECT_TRUE(waitFor([&] { return fired == 1; }));
+  EXPECT_LT(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 1.0);
+
+  // the periodic timer is called once for the jump, not once per missed period
+  sleepMs(50);
+  EXPECT_GE(periodic, 1);
+  EXPECT_LE(periodic, 2);
+
+  wheel.cancel(periodicTimer);
+}
+
+TEST(TimerWheelTest, jumpBeyondTheWheelSpan)
+{
+  auto &wheel = TimerWheel::getInstance();
+  std::atomic<int> fired(0);
+
+  // the wheel spans 2^32 ticks (~49.7 days with the default resolution)
+  wheel.schedule(ros::Duration(1.0), [&] { fired++; });
+  advance(100 * DAY);
+  EXPECT_TRUE(waitFor([&] { return fired == 1; }));
+}
+
+TEST(TimerWheelTest, timerLongerThanTheWheelSpan)
+{
+  auto &wheel = TimerWheel::getInstance();
+  std::atomic<int> fired(0);
+
+  wheel.schedule(ros::Duration(60 * DAY), [&] { fired++; });
+
+  advance(59.9 * DAY);
+  sleepMs(100);
+  EXPECT_EQ(fired, 0);
+
+  advance(0.2 * DAY);
+  EXPECT_TRUE(waitFor([&] { return fired == 1; }));
+}
+
+TEST(TimerWheelTest, cancelledTimerIsNotCalled)
+{
+  auto &wheel = TimerWheel::getInstance();
+  std::atomic<int> fired(0);
+
+  auto timer = wheel.schedule(ros::Duration(0.5), [&] { fired++; });
+  wheel.cancel(timer);
+
+  advance(1.0);
+  sleepMs(100);
+  EXPECT_EQ(fired, 0);
+}
+
+TEST(SmaccWatchdogTest, fedWatchdogDoesNotTimeout)
+{
+  std::atomic<int> timeouts(0);
+
+  // the watchdog is the only timer: the wheel thread sleeps until its deadline while it is fed, so it is not a
+  // source of current time for feed(). The time advances several timeouts per wheel thread wake up
+  SmaccWatchdog watchdog;
+  watchdog.start(ros::Duration(0.3), [&] { timeouts++; });
+
+  for (int i = 0; i < 2000; i++)
+  {
+    advance(0.05);
+    watchdog.feed();
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+
+  watchdog.stop();
+  EXPECT_EQ(timeouts, 0);
+}
+
+TEST(SmaccWatchdogTest, starvedWatchdogTimesOutOnce)
+{
+  std::atomic<int> timeouts(0);
+
+  SmaccWatchdog watchdog;
+  watchdog.start(ros::Duration(1.0), [&] { timeouts++; });
+  watchdog.feed();
+
+  advance(1.5);
+  EXPECT_TRUE(waitFor([&] { return timeouts >= 1; }));
+  sleepMs(50);
+  EXPECT_EQ(timeouts, 1);
+
+  watchdog.stop();
+}
+
+TEST(SmaccWatchdogTest, stopWhileTheTimeoutCallbackIsBlocked)
+{
+  // the timeout callback takes a lock held by the thread that stops the watchdog (ie: postEvent and the state
+  // machine mutex)
+  std::mutex stateMachineMutex;
+  std::atomic<int> timeouts(0);
+
+  SmaccWatchdog watchdog;
+  watchdog.start(ros::Duration(1.0), [&] {
+    std::lock_guard<std::mutex> lock(stateMachineMutex);
+    timeouts++;
+  });
+
+  {
+    std::lock_guard<std::mutex> lock(stateMachineMutex);
+    advance(1.5);
+    sleepMs(50);
+    watchdog.stop();
+  }
+
+  EXPECT_TRUE(waitFor([&] { return timeouts == 1; }));
+}
+
+int main(int argc, char **argv)
+{
+  ros::init(argc, argv, "timer_wheel_test", ros::init_options::NoRosout);
+  testing::InitGoogleTest(&argc, argv);
+
+  // simulated time before the wheel is created
+  ros::Time::setNow(ros::Time(simTime));
+  return RUN_ALL_TESTS();
+}
@@ -2,6 +2,7 @@
 #pragma once
 #include <smacc/smacc.h>
 #include <smacc/client_base_components/cp_topic_subscriber.h>
+#include <smacc/smacc_service_call_pool.h>
 #include <boost/optional/optional_io.hpp>
 
 #include <microstrain_mips/SetGyroBiasModel.h>
@@ -49,6 +50,7 @@ public:
     smacc::components::CpTopicSubscriber<microstrain_mips::status_msg> *statusSubscriber;
 
     ClMicrostainMips()
+        : asyncCalls_(1)
     {
         initialized_ = false;
     }
@@ -142,6 +144,29 @@ public:
         this->statusSubscriber = this->createComponent<decltype(this), TObjectTag, smacc::components::CpTopicSubscriber<microstrain_mips::status_msg>>("imu/data");
     }
 
+    // Non blocking call of any of the driver services, ie: callAsync<std_srvs::Trigger>("gyro_bias_capture", req, onDone).
+    // The calls are executed in order in a worker thread. The callback is called from that thread, with success false
+    // if the call failed or the timeout expired
+    template <typename TService>
+    unsigned long callAsync(std::string serviceName, const typename TService::Request &request,
+                            std::function<void(bool, const typename TService::Response &)> onDone,
+                            ros::Duration timeout = ros::Duration(5))
+    {
+        if (!nodeName_)
+        {
+            ROS_ERROR("[%s] asynchronous call with no node name set. Skipping.", this->getName().c_str());
+            return 0;
+        }
+
+        return asyncCalls_.call<TService>(nh_.resolveName(*nodeName_ + "/" + serviceName), request, timeout,
+                                          [onDone](unsigned long, bool success, const typename TService::Response &res, const std::string &error) {
+                                              if (!success)
+                                                  ROS_WARN("[ClMicrostainMips] %s", error.c_str());
+
+                                              onDone(success, res);
+                                          });
+    }
+
     void resetFilter()
     {
         std_srvs::Empty::Request req;
@@ -677,5 +702,9 @@ protected:
     ros::ServiceClient getMagDipAdaptiveValsSrv;       // get_mag_dip_adaptive_vals - std_srvs::Trigger
     ros::ServiceClient getSensorVehicleFrameOffsetSrv; // get_sensor_vehicle_frame_offset - std_srvs::Trigger
     ros::ServiceClient getGynamicsModeSrv;             // get_dynamics_mode - std_srvs::Trigger
+
+private:
+    // one worker: the device configuration calls are applied in order
+    smacc::ServiceCallPool asyncCalls_;
 };
 }
\ No newline at end of file
@@ -12,6 +12,10 @@
 #include <pcl/point_types.h>
 #include <ros/ros.h>
 #include <backward_global_planner/command.h>
+#include <forward_global_planner/plan_validator.h>
+#include <forward_global_planner/shared_trail.h>
+#include <forward_global_planner/trail_index.h>
+#include <memory>
 
 namespace cl_move_base_z
 {
@@ -50,9 +54,19 @@ private:
 
     nav_msgs::Path lastForwardPathMsg_;
 
+    /// odom tracker trail in shared memory, used instead of the odom_tracker_path topic if available
+    std::unique_ptr<SharedTrailReader> sharedTrail_;
+
+    uint64_t sharedTrailVersion_;
+
+    /// spatial index of lastForwardPathMsg_ for the closest point queries
+    TrailIndex trailIndex_;
+
     /// stored but almost not used
     costmap_2d::Costmap2DROS *costmap_ros_;
 
+    PlanValidator planValidator_;
+
     void onForwardTrailMsg(const nav_msgs::Path::ConstPtr &trailMessage);
 
     void publishGoalMarker(const geometry_msgs::Pose &pose, double r, double g, double b);
@@ -35,6 +35,7 @@ namespace backward_global_planner
 BackwardGlobalPlanner::BackwardGlobalPlanner()
 {
     skip_straight_motion_distance_ = 0.2;
+    sharedTrailVersion_ = 0;
 }
 
 BackwardGlobalPlanner::~BackwardGlobalPlanner()
@@ -56,6 +57,19 @@ void BackwardGlobalPlanner::initialize(std::string name, costmap_2d::Costmap2DRO
     costmap_ros_ = costmap_ros;
     //ROS_WARN_NAMED("Backwards", "initializating global planner, costmap address: %ld", (long)costmap_ros);
 
+    ros::NodeHandle private_nh("~/" + name);
+    bool useSharedTrail;
+    private_nh.param("use_shared_trail", useSharedTrail, true);
+
+    if (useSharedTrail)
+    {
+        // the trail is read from the odom tracker shared memory when a plan is requested, no messages are needed
+        std::string sharedTrailName;
+        private_nh.param("shared_trail_name", sharedTrailName, getDefaultSharedTrailName());
+        sharedTrail_.reset(new SharedTrailReader(sharedTrailName));
+    }
+
+    // with the shared trail, the topic is only kept until the shared memory trail is available
     forwardPathSub_ = nh_.subscribe("odom_tracker_path", 2, &BackwardGlobalPlanner::onForwardTrailMsg, this);
 
     ros::NodeHandle nh;
@@ -167,45 +181,30 @@ bool BackwardGlobalPlanner::createDefaultBackwardPath(const geometry_msgs::PoseS
 
     plan.push_back(pose);
 
-    //ROS_WARN_NAMED("Backwards", "Iterating in last forward cord path");
-    int i = lastForwardPathMsg_.poses.size();
-    double mindist = std::numeric_limits<double>::max();
-    int mindistindex = -1;
-
-    geometry_msgs::Pose goalProjected;
-
-    for (auto &p : lastForwardPathMsg_.poses | boost::adaptors::reversed)
-    {
-        pose = p;
-        pose.header.frame_id = costmap_ros_->getGlobalFrameID();
-        pose.header.stamp = ros::Time::now();
-
-        double dx = pose.pose.position.x - goal.pose.position.x;
-        double dy = pose.pose.position.y - goal.pose.position.y;
-
-        double dist = sqrt(dx * dx + dy * dy);
-        if (dist <= mindist)
-        {
-            mindistindex = i;
-            mindist = dist;
-            goalProjected = pose.pose;
-        }
-
-        i--;
-    }
+    // the index only processes the poses appended since the last plan
+    trailIndex_.sync(lastForwardPathMsg_.poses);
+    int mindistindex = trailIndex_.nearest(goal.pose.position.x, goal.pose.position.y);
 
     if (mindistindex != -1)
     {
+        // the plan poses are expressed in the costmap frame and stamped with the plan time
+        const std::string &frameId = costmap_ros_->getGlobalFrameID();
+        auto stamp = ros::Time::now();
+
+        plan.reserve(plan.size() + lastForwardPathMsg_.poses.size() - mindistindex);
         for (int i = lastForwardPathMsg_.poses.size() - 1; i >= mindistindex; i--)
         {
-            auto &pose = lastForwardPathMsg_.poses[i];
-            plan.push_back(pose);
+            plan.push_back(lastForwardPathMsg_.poses[i]);
+            plan.back().header.frame_id = frameId;
+            plan.back().header.stamp = stamp;
         }
     }
     else
     {
         ROS_WARN_STREAM("Creating the backwards plan, it is not found any close trajectory point. Last forward path plan message size: " << lastForwardPathMsg_.poses.size());
     }
+
+    return mindistindex != -1;
 }
 
 /**
@@ -221,6 +220,23 @@ bool BackwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
 
     plan.clear();
 
+    if (sharedTrail_)
+    {
+        // only copied if the odom tracker modified it since the last plan
+        sharedTrail_->readIfUpdated(lastForwardPathMsg_, sharedTrailVersion_);
+
+        if (sharedTrail_->isAttached() && forwardPathSub_)
+        {
+            ROS_INFO("[BackwardGlobalPlanner] shared memory trail available, unsubscribing from odom_tracker_path");
+            forwardPathSub_.shutdown();
+        }
+        else if (!sharedTrail_->isAttached() && !forwardPathSub_)
+        {
+            ROS_WARN("[BackwardGlobalPlanner] shared memory trail not available, subscribing to odom_tracker_path");
+            forwardPathSub_ = nh_.subscribe("odom_tracker_path", 2, &BackwardGlobalPlanner::onForwardTrailMsg, this);
+        }
+    }
+
     this->createDefaultBackwardPath(start, goal, plan);
     //this->createPureSpiningAndStragihtLineBackwardPath(start, goal, plan);
 
@@ -248,32 +264,27 @@ bool BackwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
     planMsg.poses = plan;
     planMsg.header.frame_id = this->costmap_ros_->getGlobalFrameID();
 
-        // check plan rejection
+    // check plan rejection
     bool acceptedGlobalPlan = true;
 
-    // static const unsigned char NO_INFORMATION = 255;
-    // static const unsigned char LETHAL_OBSTACLE = 254;
-    // static const unsigned char INSCRIBED_INFLATED_OBSTACLE = 253;
-    // static const unsigned char FREE_SPACE = 0;
-
+    // the whole segments between poses are checked (not only the vertices), with the footprint swept along them
     costmap_2d::Costmap2D *costmap2d = this->costmap_ros_->getCostmap();
-    for (auto &p : plan)
+    planValidator_.setFootprint(this->costmap_ros_->getRobotFootprint());
+
+    int collisionIndex;
+    if (!planValidator_.validate(*costmap2d, plan, &collisionIndex))
     {
-        unsigned int mx, my;
-        costmap2d->worldToMap(p.pose.position.x, p.pose.position.y, mx, my);
-        auto cost = costmap2d->getCost(mx, my);
+        acceptedGlobalPlan = false;
+        ROS_WARN_STREAM("[Backward Global Planner] plan rejected, collision in the segment starting at pose " << collisionIndex << "/" << plan.size());
+    }
 
-        if (cost >= costmap_2d::INSCRIBED_INFLATED_OBSTACLE)
-        {
-            acceptedGlobalPlan = false;
-            break;
-        }
+    if (acceptedGlobalPlan)
+    {
+        planPub_.publish(planMsg);
     }
-    
-    planPub_.publish(planMsg);
 
     // this was previously set to size() <= 1, but a plan with a single point is also a valid plan (the goal)
-    return true;
+    return acceptedGlobalPlan;
 }
 
 /**
@@ -286,8 +297,7 @@ bool BackwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
                                      double &cost)
 {
     cost = 0;
-    makePlan(start, goal, plan);
-    return true;
+    return makePlan(start, goal, plan);
 }
 
 /**
@@ -11,6 +11,8 @@
 #include <tf/tf.h>
 #include <tf/transform_listener.h>
 #include <tf2_ros/buffer.h>
+#include <forward_global_planner/trail_index.h>
+#include <forward_global_planner/trajectory_rollout.h>
 #include <Eigen/Eigen>
 
 typedef double meter;
@@ -106,8 +108,17 @@ private:
     // references the current point inside the backwardsPlanPath were the robot is located
     int currentCarrotPoseIndex_;
 
-    void generateTrajectory(const Eigen::Vector3f &pos, const Eigen::Vector3f &vel, float maxdist, float maxangle, float maxtime, float dt, std::vector<Eigen::Vector3f> &outtraj);
-    Eigen::Vector3f computeNewPositions(const Eigen::Vector3f &pos, const Eigen::Vector3f &vel, double dt);
+    // spatial index of backwardsPlanPath_ used to find the carrot goal on new plans
+    TrailIndex planIndex_;
+
+    std::vector<int> carrotCandidates_;
+
+    // if the command of the controller collides, the closest collision free variant of it is used
+    bool enable_command_sampling_;
+
+    TrajectoryRollout rollout_;
+
+    std::vector<Eigen::Vector3f> commandSamples_;
 
     bool waiting_;
     ros::Duration waitingTimeout_;
@@ -64,6 +64,9 @@ namespace cl_move_base_z
 
             nh.param("max_linear_x_speed", max_linear_x_speed_, 1.0);
             nh.param("max_angular_z_speed", max_angular_z_speed_, 2.0);
+            nh.param("enable_command_sampling", enable_command_sampling_, false);
+
+            rollout_.configure(0.05 /*seconds*/, 3.0 /*seconds*/);
 
             goalMarkerPublisher_ = nh.advertise<visualization_msgs::MarkerArray>("goal_marker", 1);
             waitingTimeout_ = ros::Duration(10);
@@ -309,53 +312,44 @@ namespace cl_move_base_z
 
             Eigen::Vector3f currentpose(pos.x(), pos.y(), yaw);
             Eigen::Vector3f currentvel(cmd_vel.linear.x, cmd_vel.linear.y, cmd_vel.angular.z);
-            std::vector<Eigen::Vector3f> trajectory;
-            this->generateTrajectory(currentpose, currentvel, 0.8 /*meters*/, M_PI / 8 /*rads*/, 3.0 /*seconds*/, 0.05 /*seconds*/, trajectory);
 
             // check plan rejection
             bool aceptedplan = true;
 
-            unsigned int mx, my;
-
             if (this->enable_obstacle_checking_)
             {
                 if (backwardsPlanPath_.size() > 0)
                 {
                     auto &finalgoalpose = backwardsPlanPath_.back();
 
-                    int i = 0;
-                    // ROS_INFO_STREAM("lplanner goal: " << finalgoalpose.pose.position);
-                    for (auto &p : trajectory)
+                    commandSamples_.clear();
+                    if (enable_command_sampling_)
                     {
-                        float dx = p[0] - finalgoalpose.pose.position.x;
-                        float dy = p[1] - finalgoalpose.pose.position.y;
-
-                        float dst = sqrt(dx * dx + dy * dy);
-                        if (dst < xy_goal_tolerance_)
-                        {
-                            ROS_INFO("trajectory checking skipped, goal reached");
-                            break;
-                        }
-
-                        costmap2d->worldToMap(p[0], p[1], mx, my);
-                        unsigned int cost = costmap2d->getCost(mx, my);
-
-                        ROS_DEBUG("checking cost pt %d [%lf, %lf] cell[%d,%d] = %d", i, p[0], p[1], mx, my, cost);
-                        ROS_DEBUG_STREAM("cost: " << cost);
-
-                        // static const unsigned char NO_INFORMATION = 255;
-                        // static const unsigned char LETHAL_OBSTACLE = 254;
-                        // static const unsigned char INSCRIBED_INFLATED_OBSTACLE = 253;
-                        // static const unsigned char FREE_SPACE = 0;
-
-                        if (costmap2d->getCost(mx, my) >= costmap_2d::INSCRIBED_INFLATED_OBSTACLE)
-                        {
-                            aceptedplan = false;
-                            ROS_WARN_STREAM("ABORTED LOCAL PLAN BECAUSE OBSTACLE DETEDTED at point " << i << "/" << trajectory.size() << std::endl
-                                                                                                     << p[0] << ", " << p[1]);
-                            break;
-                        }
-                        i++;
+                        TrajectoryRollout::sampleCommands(currentvel, max_linear_x_speed_, max_angular_z_speed_, commandSamples_);
+                    }
+                    else
+                    {
+                        commandSamples_.push_back(currentvel);
+                    }
+
+                    // all the samples are simulated and checked against the footprint in a single batch
+                    rollout_.setFootprint(costmapRos_->getRobotFootprint(), costmap2d->getResolution());
+                    rollout_.simulate(currentpose, commandSamples_);
+                    rollout_.checkCollisions(*costmap2d, finalgoalpose.pose.position.x, finalgoalpose.pose.position.y, xy_goal_tolerance_);
+
+                    int bestSample = rollout_.getBestCollisionFreeSample(currentvel, max_linear_x_speed_, max_angular_z_speed_);
+                    if (bestSample == -1)
+                    {
+                        aceptedplan = false;
+                        ROS_WARN_STREAM("ABORTED LOCAL PLAN BECAUSE OBSTACLE DETEDTED at point " << rollout_.getCollisionStep(0) << "/" << rollout_.steps());
+                    }
+                    else if (bestSample != 0)
+                    {
+                        auto &sample = commandSamples_[bestSample];
+                        ROS_DEBUG("[BackwardLocalPlanner] controller command collides, using sample %d: v=%f w=%f", bestSample, sample[0], sample[2]);
+                        cmd_vel.linear.x = sample[0];
+                        cmd_vel.linear.y = sample[1];
+                        cmd_vel.angular.z = sample[2];
                     }
                 }
                 else
@@ -462,38 +456,47 @@ namespace cl_move_base_z
                 tf::poseStampedMsgToTF(plan[0], tfpose);
             }
 
-            int closestIndex = -1;
-            double minpointdist = std::numeric_limits<double>::max();
+            // lets set the carrot-goal in the corret place: the first pose inside the carrot range (only the poses
+            // close to the robot are checked) and then advance while the following poses are still in range
+            // a new plan may have the same size and end as the previous one, the index is always rebuilt
+            planIndex_.clear();
+            planIndex_.sync(backwardsPlanPath_);
+            planIndex_.radiusSearch(tfpose.getOrigin().x(), tfpose.getOrigin().y(), carrot_distance_, carrotCandidates_);
 
-            // lets set the carrot-goal in the corret place with this loop
-            while (currentCarrotPoseIndex_ < backwardsPlanPath_.size())
+            for (int candidate : carrotCandidates_)
             {
+                currentCarrotPoseIndex_ = candidate;
                 computeCurrentEuclideanAndAngularErrors(tfpose, disterr, angleerr);
 
                 ROS_DEBUG("Current index: %d", currentCarrotPoseIndex_);
                 ROS_DEBUG("linear error to goal %lf, angular error to goal: %lf", disterr, angleerr);
 
-                if (found)
+                // target pose found, goal carrot tries to escape!
+                if (angleerr < carrot_angular_distance_)
                 {
-                    // we were inside the goal range
+                    found = true;
+                    break;
+                }
+            }
+
+            if (found)
+            {
+                // we are inside the goal range, we stop at the last pose inside the carrot goal scope
+                while (currentCarrotPoseIndex_ + 1 < (int)backwardsPlanPath_.size())
+                {
+                    currentCarrotPoseIndex_++;
+                    computeCurrentEuclideanAndAngularErrors(tfpose, disterr, angleerr);
+
                     if (disterr > carrot_distance_ || angleerr > carrot_angular_distance_)
                     {
-                        // but we rollback last index increment (to go back inside the carrot goal scope) and start motion with that carrot goal we found
                         currentCarrotPoseIndex_--;
                         break;
                     }
                 }
-                else
-                {
-                    // target pose found, goal carrot tries to escape!
-                    if (disterr < carrot_distance_ && angleerr < carrot_angular_distance_)
-                    {
-                        found = true;
-                        // we are inside the goal range
-                    }
-                }
-
-                currentCarrotPoseIndex_++;
+            }
+            else
+            {
+                currentCarrotPoseIndex_ = backwardsPlanPath_.size() - 1;
             }
 
             if (!found)
@@ -507,77 +510,6 @@ namespace cl_move_base_z
             }
         }
 
-        void BackwardLocalPlanner::generateTrajectory(const Eigen::Vector3f &pos, const Eigen::Vector3f &vel, float maxdist, float maxanglediff, float maxtime, float dt, std::vector<Eigen::Vector3f> &outtraj)
-        {
-            //simulate the trajectory and check for collisions, updating costs along the way
-            bool end = false;
-            float time = 0;
-            Eigen::Vector3f currentpos = pos;
-            int i = 0;
-            while (!end)
-            {
-                //add the point to the trajectory so we can draw it later if we want
-                //traj.addPoint(pos[0], pos[1], pos[2]);
-
-                // if (continued_acceleration_) {
-                //   //calculate velocities
-                //   loop_vel = computeNewVelocities(sample_target_vel, loop_vel, limits_->getAccLimits(), dt);
-                //   //ROS_WARN_NAMED("Generator", "Flag: %d, Loop_Vel %f, %f, %f", continued_acceleration_, loop_vel[0], loop_vel[1], loop_vel[2]);
-                // }
-
-                auto loop_vel = vel;
-                //update the position of the robot using the velocities passed in
-                auto newpos = computeNewPositions(currentpos, loop_vel, dt);
-
-                auto dx = newpos[0] - currentpos[0];
-                auto dy = newpos[1] - currentpos[1];
-                float dist, angledist;
-
-                //ROS_INFO("traj point %d", i);
-                dist = sqrt(dx * dx + dy * dy);
-                if (dist > maxdist)
-                {
-                    end = true;
-                    //ROS_INFO("dist break: %f", dist);
-                }
-                else
-                {
-                    // ouble from, double to
-                    angledist = angles::shortest_angular_distance(currentpos[2], newpos[2]);
-                    if (angledist > maxanglediff)
-                    {
-                        end = true;
-                        //ROS_INFO("angle dist break: %f", angledist);
-                    }
-                    else
-                    {
-                        outtraj.push_back(newpos);
-
-                        time += dt;
-                        if (time > maxtime)
-                        {
-                            end = true;
-                            //ROS_INFO("time break: %f", time);
-                        }
-
-                        //ROS_INFO("dist: %f, angledist: %f, time: %f", dist, angledist, time);
-                    }
-                }
-
-                currentpos = newpos;
-                i++;
-            } // end for simulation steps
-        }
-
-        Eigen::Vector3f BackwardLocalPlanner::computeNewPositions(const Eigen::Vector3f &pos, const Eigen::Vector3f &vel, double dt)
-        {
-            Eigen::Vector3f new_pos = Eigen::Vector3f::Zero();
-            new_pos[0] = pos[0] + (vel[0] * cos(pos[2]) + vel[1] * cos(M_PI_2 + pos[2])) * dt;
-            new_pos[1] = pos[1] + (vel[0] * sin(pos[2]) + vel[1] * sin(M_PI_2 + pos[2])) * dt;
-            new_pos[2] = pos[2] + vel[2] * dt;
-            return new_pos;
-        }
-
         /**
 ******************************************************************************************************************
 * publishGoalMarker()
@@ -0,0 +1,110 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+namespace cl_move_base_z
+{
+// Helpers of the uniform grid spatial indexes (TrailIndex, WaypointRoute): cell keys, bounds of the occupied
+// cells and the ring search of the closest point.
+
+// key of the cell (cx, cy) in a hash map. The coordinates are reinterpreted as unsigned before the shift,
+// shifting a negative int is undefined
+inline int64_t gridCellKey(int cx, int cy)
+{
+    return (int64_t)(((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy);
+}
+
+// bounds of the cells that contain (or contained) points
+struct CellBounds
+{
+    int minX, maxX, minY, maxY;
+
+    CellBounds() { reset(); }
+
+    inline void reset()
+    {
+        minX = minY = std::numeric_limits<int>::max();
+        maxX = maxY = std::numeric_limits<int>::min();
+    }
+
+    inline bool empty() const { return minX > maxX; }
+
+    inline void expand(int cx, int cy)
+    {
+        minX = std::min(minX, cx);
+        maxX = std::max(maxX, cx);
+        minY = std::min(minY, cy);
+        maxY = std::max(maxY, cy);
+    }
+};
+
+/**
+******************************************************************************************************************
+* visitCellRings()
+******************************************************************************************************************
+*/
+// Visits the cells around (cx, cy) in square rings of increasing radius (in cells), for closest point searches.
+// Only the part of each ring inside bounds is visited: the rings start at the first one that reaches the bounds
+// and end at the last one that still overlaps them, so a far query does not scan empty cells.
+// stop(ring) is checked before each ring (ie: the closest point found is closer than the ring).
+template <typename TVisitCell, typename TStop>
+void visitCellRings(int cx, int cy, const CellBounds &bounds, TVisitCell visitCell, TStop stop)
+{
+    if (bounds.empty())
+        return;
+
+    int minRing = std::max(std::max(std::max(bounds.minX - cx, cx - bounds.maxX), std::max(bounds.minY - cy, cy - bounds.maxY)), 0);
+    int maxRing = std::max(std::max(std::abs(cx - bounds.minX), std::abs(bounds.maxX - cx)),
+                           std::max(std::abs(cy - bounds.minY), std::abs(bounds.maxY - cy)));
+
+    for (int ring = minRing; ring <= maxRing; ring++)
+    {
+        if (stop(ring))
+            break;
+
+        if (ring == 0)
+        {
+            visitCell(cx, cy);
+            continue;
+        }
+
+        // top and bottom rows
+        int fromX = std::max(cx - ring, bounds.minX);
+        int toX = std::min(cx + ring, bounds.maxX);
+        if (cy - ring >= bounds.minY)
+        {
+            for (int i = fromX; i <= toX; i++)
+                visitCell(i, cy - ring);
+        }
+
+        if (cy + ring <= bounds.maxY)
+        {
+            for (int i = fromX; i <= toX; i++)
+                visitCell(i, cy + ring);
+        }
+
+        // left and right columns, without the corners
+        int fromY = std::max(cy - ring + 1, bounds.minY);
+        int toY = std::min(cy + ring - 1, bounds.maxY);
+        if (cx - ring >= bounds.minX)
+        {
+            for (int j = fromY; j <= toY; j++)
+                visitCell(cx - ring, j);
+        }
+
+        if (cx + ring <= bounds.maxX)
+        {
+            for (int j = fromY; j <= toY; j++)
+                visitCell(cx + ring, j);
+        }
+    }
+}
+} // namespace cl_move_base_z
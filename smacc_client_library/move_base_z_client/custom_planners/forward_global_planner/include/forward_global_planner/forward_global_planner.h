@@ -8,16 +8,32 @@
 #include <nav_msgs/GetPlan.h>
 #include <nav_msgs/Path.h>
 #include <ros/ros.h>
+#include <forward_global_planner/plan_validator.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace cl_move_base_z
 {
 namespace forward_global_planner
 {
+// Look-ahead planning: the upcoming goals of a route (ie: the next waypoints) can be published in
+// ~/ForwardGlobalPlanner/lookahead_goals. While the robot drives to the first of them, a background thread
+// plans every goal from the previous one on a copy of the costmap and caches the collision free plans.
+// When makePlan is requested for a cached goal (from a start close to the previous goal) the cached plan is
+// used. The background thread revalidates the cached plans periodically and discards those whose corridor
+// has new obstacles.
+//
+// parameters (~ForwardGlobalPlanner/):
+//   lookahead_start_tolerance: max distance (m) between the start and the cached plan start
+//   lookahead_revalidation_period: period (s) of the revalidation of the cached plans
 class ForwardGlobalPlanner : public nav_core::BaseGlobalPlanner
 {
 public:
     ForwardGlobalPlanner();
 
+    virtual ~ForwardGlobalPlanner();
+
     bool makePlan(const geometry_msgs::PoseStamped &start,
                   const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan);
 
@@ -35,9 +51,52 @@ private:
     /// stored but almost not used
     costmap_2d::Costmap2DROS *costmap_ros_;
 
+    PlanValidator planValidator_;
+
     double skip_straight_motion_distance_; //meters
 
     double puresSpinningRadStep_; // rads
+
+    // spin - straight line - spin plan
+    void generatePlan(const geometry_msgs::PoseStamped &start,
+                      const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan);
+
+    // ------ look-ahead planning ------
+    struct CachedPlan
+    {
+        geometry_msgs::PoseStamped start;
+        geometry_msgs::PoseStamped goal;
+        std::vector<geometry_msgs::PoseStamped> plan;
+    };
+
+    ros::Subscriber lookAheadGoalsSub_;
+
+    std::thread lookAheadThread_;
+    std::mutex lookAheadMutex_;
+    std::condition_variable lookAheadCondition_;
+    bool lookAheadShutdown_;
+    bool lookAheadGoalsUpdated_;
+    std::vector<geometry_msgs::PoseStamped> lookAheadGoals_;
+    std::vector<CachedPlan> cachedPlans_;
+
+    // only used from the look-ahead thread
+    PlanValidator lookAheadValidator_;
+
+    double lookAheadStartTolerance_;
+    double lookAheadRevalidationPeriod_;
+
+    void onLookAheadGoals(const nav_msgs::Path::ConstPtr &goals);
+
+    void lookAheadLoop();
+
+    // plans (or revalidates the cached plans) of the look-ahead goals on a costmap snapshot
+    std::vector<CachedPlan> updateLookAheadPlans(const std::vector<geometry_msgs::PoseStamped> &goals,
+                                                 const std::vector<CachedPlan> &previousPlans);
+
+    // takes the cached plan of goal if it starts close (lookahead_start_tolerance, any heading) to start. The
+    // returned plan joins start to the cached plan
+    bool takeCachedPlan(const geometry_msgs::PoseStamped &start,
+                        const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan);
 };
 } // namespace forward_global_planner
 } // namespace cl_move_base_z
\ No newline at end of file
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <ros/ros.h>
+#include <geometry_msgs/Point.h>
 #include <geometry_msgs/PoseStamped.h>
 
 namespace cl_move_base_z
@@ -18,4 +19,8 @@ geometry_msgs::PoseStamped makePureStraightSubPlan(const geometry_msgs::PoseStam
                                                    double lenght,
                                                    std::vector<geometry_msgs::PoseStamped> &plan);
 
+// points along the footprint polygon (robot frame) spaced at most resolution meters
+void sampleFootprintPerimeter(const std::vector<geometry_msgs::Point> &footprint, double resolution,
+                              std::vector<float> &xs, std::vector<float> &ys);
+
 } // namespace cl_move_base_z
\ No newline at end of file
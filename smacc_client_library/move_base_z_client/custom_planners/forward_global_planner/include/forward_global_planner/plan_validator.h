@@ -0,0 +1,41 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <costmap_2d/costmap_2d.h>
+#include <geometry_msgs/Point.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <vector>
+
+namespace cl_move_base_z
+{
+// Collision validation of a global plan. Every segment between consecutive plan poses is rasterized (DDA) and
+// its cells are checked with the inscribed cost, and the footprint perimeter is swept along the segment
+// (interpolating position and heading) and checked with the lethal cost. The costmap is read once under its
+// lock, so a plan can be revalidated at replanning rate.
+class PlanValidator
+{
+public:
+    PlanValidator();
+
+    // footprint in the robot frame
+    void setFootprint(const std::vector<geometry_msgs::Point> &footprint);
+
+    // returns true if the plan is collision free. Otherwise collisionIndex (optional) is the index of the
+    // pose that starts the colliding segment. The cell and the footprint of the first pose (robot location) are
+    // not checked, wherever the plan repeats that pose
+    bool validate(costmap_2d::Costmap2D &costmap, const std::vector<geometry_msgs::PoseStamped> &plan,
+                  int *collisionIndex = nullptr);
+
+private:
+    std::vector<geometry_msgs::Point> footprint_;
+
+    // footprint perimeter sampled at the resolution of the last validated costmap
+    std::vector<float> perimeterX_, perimeterY_;
+    double perimeterResolution_;
+    double footprintRadius_;
+};
+} // namespace cl_move_base_z
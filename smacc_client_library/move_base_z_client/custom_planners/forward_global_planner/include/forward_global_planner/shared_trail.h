@@ -0,0 +1,82 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <ros/ros.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <nav_msgs/Path.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <memory>
+
+namespace cl_move_base_z
+{
+struct SharedTrailHeader;
+struct SharedTrailPose;
+
+// default shared memory name of the odom tracker trail for the current ros namespace
+std::string getDefaultSharedTrailName();
+
+// Ring of trail poses in shared memory. The odom tracker writes its current path and the backward planners
+// map it read-only, so that planning requests read the latest trail without any message traffic.
+// Single writer, multiple readers, synchronized with a seqlock: readers never block the writer, they retry
+// if the trail was modified while they were copying it.
+class SharedTrailWriter
+{
+public:
+    // if the trail is longer than capacity, only the last capacity poses are kept (with a throttled warning)
+    SharedTrailWriter(const std::string &name, size_t capacity);
+
+    // removes the segment
+    ~SharedTrailWriter();
+
+    void append(const geometry_msgs::PoseStamped &pose);
+
+    void removeLast();
+
+    void reset(const std::vector<geometry_msgs::PoseStamped> &poses);
+
+    void setFrameId(const std::string &frameId);
+
+private:
+    void beginWrite();
+
+    void endWrite();
+
+    void writePose(size_t slot, const geometry_msgs::PoseStamped &pose);
+
+    void warnTruncated();
+
+    std::string name_;
+    boost::interprocess::shared_memory_object shm_;
+    boost::interprocess::mapped_region region_;
+    SharedTrailHeader *header_;
+    SharedTrailPose *poses_;
+};
+
+class SharedTrailReader
+{
+public:
+    SharedTrailReader(const std::string &name);
+
+    // copies the trail if its version is newer than lastVersion. Returns false if the trail is not available
+    // (the writer did not create it yet) or it did not change
+    bool readIfUpdated(nav_msgs::Path &path, uint64_t &lastVersion);
+
+    // true while the trail of a running writer is mapped
+    inline bool isAttached() const { return header_ != nullptr; }
+
+private:
+    bool open();
+
+    std::string name_;
+    std::unique_ptr<boost::interprocess::shared_memory_object> shm_;
+    std::unique_ptr<boost::interprocess::mapped_region> region_;
+    const SharedTrailHeader *header_;
+    const SharedTrailPose *poses_;
+    uint64_t capacity_;
+};
+} // namespace cl_move_base_z
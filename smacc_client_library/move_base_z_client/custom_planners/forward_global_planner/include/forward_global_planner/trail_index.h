@@ -0,0 +1,60 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <forward_global_planner/cell_grid.h>
+#include <geometry_msgs/PoseStamped.h>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace cl_move_base_z
+{
+// Uniform grid over the xy positions of a trail (recorded path or plan). Closest point and radius queries only
+// visit the cells around the query point instead of scanning the whole trail. The index follows the trail
+// incrementally: poses are appended or removed at the end as the trail grows or is cleared.
+class TrailIndex
+{
+public:
+    TrailIndex(double cellSize = 0.25);
+
+    void clear();
+
+    void append(double x, double y);
+
+    void removeLast();
+
+    inline size_t size() const { return points_.size(); }
+
+    // updates the index to the given trail. If the trail only grew since the last call, only the new poses
+    // are indexed, otherwise it is rebuilt. A trail is considered grown if its first pose and the last indexed
+    // pose did not change: a trail replaced by another one (ie: a new plan) must be clear()ed first
+    void sync(const std::vector<geometry_msgs::PoseStamped> &trail);
+
+    // index of the closest pose (the lowest index on ties), -1 if the index is empty
+    int nearest(double x, double y) const;
+
+    // indexes of the poses closer than radius, sorted in ascending order
+    void radiusSearch(double x, double y, double radius, std::vector<int> &indexes) const;
+
+private:
+    struct Point
+    {
+        double x, y;
+    };
+
+    inline int cellCoord(double v) const { return (int)std::floor(v / cellSize_); }
+
+    // bounds of the cells that contain (or contained) poses
+    CellBounds bounds_;
+
+    double cellSize_;
+
+    std::vector<Point> points_;
+
+    std::unordered_map<int64_t, std::vector<int>> cells_;
+};
+} // namespace cl_move_base_z
@@ -0,0 +1,75 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <costmap_2d/costmap_2d.h>
+#include <geometry_msgs/Point.h>
+#include <Eigen/Eigen>
+#include <vector>
+
+namespace cl_move_base_z
+{
+// Rollout engine shared by the custom local planners. A batch of velocity commands (vx, vy, wz) is simulated at
+// once: the state of all the samples at each time step is stored contiguously so that the integration is
+// vectorized by Eigen across samples. Each simulated pose is checked against the costmap with the robot centre
+// and the robot footprint perimeter. The buffers are reused between control cycles.
+class TrajectoryRollout
+{
+public:
+    TrajectoryRollout();
+
+    // simulation horizon (seconds) and time step
+    void configure(float dt, float maxTime);
+
+    // footprint in the robot frame. Its perimeter is sampled at the costmap resolution
+    void setFootprint(const std::vector<geometry_msgs::Point> &footprint, double resolution);
+
+    // simulates every sample from the pose (x, y, yaw)
+    void simulate(const Eigen::Vector3f &pose, const std::vector<Eigen::Vector3f> &samples);
+
+    // checks the simulated trajectories, reading the costmap once under its lock. The checking of a trajectory
+    // stops when it gets closer than goalTolerance to the goal
+    void checkCollisions(costmap_2d::Costmap2D &costmap, float goalX, float goalY, float goalTolerance);
+
+    inline int samples() const { return collisionStep_.size(); }
+
+    inline int steps() const { return steps_; }
+
+    inline bool isCollisionFree(int sample) const { return collisionStep_[sample] < 0; }
+
+    // first colliding step of the sample, -1 if it is collision free
+    inline int getCollisionStep(int sample) const { return collisionStep_[sample]; }
+
+    void getTrajectory(int sample, std::vector<Eigen::Vector3f> &trajectory) const;
+
+    // collision free sample closest to the nominal command (normalized by the speed limits), -1 if none.
+    // The first sample is preferred on ties
+    int getBestCollisionFreeSample(const Eigen::Vector3f &nominal, float maxLinearSpeed, float maxAngularSpeed) const;
+
+    // nominal command followed by slower and turning variants of it, within the speed limits
+    static void sampleCommands(const Eigen::Vector3f &nominal, float maxLinearSpeed, float maxAngularSpeed,
+                               std::vector<Eigen::Vector3f> &samples);
+
+private:
+    float dt_;
+    int steps_;
+
+    // samples x (steps + 1), column 0 is the initial pose
+    Eigen::ArrayXXf x_, y_, theta_;
+
+    Eigen::ArrayXf vx_, vy_, wz_;
+    Eigen::ArrayXf cos_, sin_;
+
+    // footprint perimeter in the robot frame and its world coordinates (scratch)
+    Eigen::ArrayXf footprintX_, footprintY_;
+    Eigen::ArrayXf worldX_, worldY_;
+
+    std::vector<geometry_msgs::Point> lastFootprint_;
+    double lastResolution_;
+
+    std::vector<int> collisionStep_;
+};
+} // namespace cl_move_base_z
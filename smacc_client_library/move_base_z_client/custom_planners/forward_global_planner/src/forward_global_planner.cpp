@@ -9,24 +9,56 @@
 #include <pluginlib/class_list_macros.h>
 #include <forward_global_planner/forward_global_planner.h>
 #include <forward_global_planner/move_base_z_client_tools.h>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <streambuf>
 #include <nav_msgs/Path.h>
 #include <angles/angles.h>
 #include <tf/tf.h>
 #include <tf/transform_datatypes.h>
+#include <costmap_2d/costmap_2d.h>
 
 namespace cl_move_base_z
 {
 namespace forward_global_planner
 {
+namespace
+{
+bool closePoses(const geometry_msgs::PoseStamped &a, const geometry_msgs::PoseStamped &b, double linearTolerance, double angularTolerance)
+{
+    double dx = a.pose.position.x - b.pose.position.x;
+    double dy = a.pose.position.y - b.pose.position.y;
+    double dyaw = angles::shortest_angular_distance(tf::getYaw(a.pose.orientation), tf::getYaw(b.pose.orientation));
+    return dx * dx + dy * dy <= linearTolerance * linearTolerance && fabs(dyaw) <= angularTolerance;
+}
+
+template <typename TCachedPlan>
+bool containsGoal(const std::vector<TCachedPlan> &plans, const geometry_msgs::PoseStamped &goal)
+{
+    return std::any_of(plans.begin(), plans.end(), [&](const TCachedPlan &p) { return closePoses(p.goal, goal, 1e-3, 1e-3); });
+}
+} // namespace
+
 ForwardGlobalPlanner::ForwardGlobalPlanner()
-    : nh_("~/ForwardGlobalPlanner")
+    : nh_("~/ForwardGlobalPlanner"), costmap_ros_(nullptr), lookAheadShutdown_(false), lookAheadGoalsUpdated_(false)
 {
     skip_straight_motion_distance_ = 0.2; //meters
     puresSpinningRadStep_ = 1000;         // rads
 }
 
+ForwardGlobalPlanner::~ForwardGlobalPlanner()
+{
+    {
+        std::lock_guard<std::mutex> lock(lookAheadMutex_);
+        lookAheadShutdown_ = true;
+    }
+    lookAheadCondition_.notify_all();
+
+    if (lookAheadThread_.joinable())
+        lookAheadThread_.join();
+}
+
 void ForwardGlobalPlanner::initialize(std::string name, costmap_2d::Costmap2DROS *costmap_ros)
 {
     ROS_INFO("[Forward Global Planner] initializing");
@@ -34,6 +66,12 @@ void ForwardGlobalPlanner::initialize(std::string name, costmap_2d::Costmap2DROS
     skip_straight_motion_distance_ = 0.2; //meters
     puresSpinningRadStep_ = 1000;         // rads
     this->costmap_ros_ = costmap_ros;
+
+    nh_.param("lookahead_start_tolerance", lookAheadStartTolerance_, 0.3);
+    nh_.param("lookahead_revalidation_period", lookAheadRevalidationPeriod_, 0.5);
+
+    lookAheadThread_ = std::thread(&ForwardGlobalPlanner::lookAheadLoop, this);
+    lookAheadGoalsSub_ = nh_.subscribe("lookahead_goals", 1, &ForwardGlobalPlanner::onLookAheadGoals, this);
 }
 
 bool ForwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
@@ -42,11 +80,11 @@ bool ForwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
 {
     ROS_INFO("[Forward Global Planner] planning");
     cost = 0;
-    makePlan(start, goal, plan);
+    return makePlan(start, goal, plan);
 }
 
-bool ForwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
-                                    const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan)
+void ForwardGlobalPlanner::generatePlan(const geometry_msgs::PoseStamped &start,
+                                        const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan)
 {
     //ROS_WARN_STREAM("Forward global plan goal: " << goal);
 
@@ -78,6 +116,19 @@ bool ForwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
     //ROS_INFO("3 - heading to goal orientation");
     double goalOrientation = angles::normalize_angle(tf::getYaw(goal.pose.orientation));
     cl_move_base_z::makePureSpinningSubPlan(prevState, goalOrientation, plan, puresSpinningRadStep_);
+}
+
+bool ForwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
+                                    const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan)
+{
+    if (this->takeCachedPlan(start, goal, plan))
+    {
+        ROS_INFO("[Forward Global Planner] using the look-ahead plan");
+    }
+    else
+    {
+        this->generatePlan(start, goal, plan);
+    }
 
     nav_msgs::Path planMsg;
     planMsg.poses = plan;
@@ -88,23 +139,15 @@ bool ForwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
     // check plan rejection
     bool acceptedGlobalPlan = true;
 
-    // static const unsigned char NO_INFORMATION = 255;
-    // static const unsigned char LETHAL_OBSTACLE = 254;
-    // static const unsigned char INSCRIBED_INFLATED_OBSTACLE = 253;
-    // static const unsigned char FREE_SPACE = 0;
-
+    // the whole segments between poses are checked (not only the vertices), with the footprint swept along them
     costmap_2d::Costmap2D *costmap2d = this->costmap_ros_->getCostmap();
-    for (auto &p : plan)
-    {
-        unsigned int mx, my;
-        costmap2d->worldToMap(p.pose.position.x, p.pose.position.y, mx, my);
-        auto cost = costmap2d->getCost(mx, my);
+    planValidator_.setFootprint(this->costmap_ros_->getRobotFootprint());
 
-        if (cost >= costmap_2d::INSCRIBED_INFLATED_OBSTACLE)
-        {
-            acceptedGlobalPlan = false;
-            break;
-        }
+    int collisionIndex;
+    if (!planValidator_.validate(*costmap2d, plan, &collisionIndex))
+    {
+        acceptedGlobalPlan = false;
+        ROS_WARN_STREAM("[Forward Global Planner] plan rejected, collision in the segment starting at pose " << collisionIndex << "/" << plan.size());
     }
 
     if (acceptedGlobalPlan)
@@ -119,6 +162,144 @@ bool ForwardGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
     }
 }
 
+/**
+******************************************************************************************************************
+* look-ahead planning
+******************************************************************************************************************
+*/
+void ForwardGlobalPlanner::onLookAheadGoals(const nav_msgs::Path::ConstPtr &goals)
+{
+    if (!goals->poses.empty() && goals->header.frame_id != this->costmap_ros_->getGlobalFrameID())
+    {
+        ROS_WARN_THROTTLE(5, "[Forward Global Planner] look-ahead goals ignored, they must be in the %s frame (they are in %s)",
+                          this->costmap_ros_->getGlobalFrameID().c_str(), goals->header.frame_id.c_str());
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(lookAheadMutex_);
+        lookAheadGoals_ = goals->poses;
+        lookAheadGoalsUpdated_ = true;
+    }
+    lookAheadCondition_.notify_all();
+}
+
+void ForwardGlobalPlanner::lookAheadLoop()
+{
+    std::unique_lock<std::mutex> lock(lookAheadMutex_);
+    while (!lookAheadShutdown_)
+    {
+        lookAheadCondition_.wait_for(lock, std::chrono::duration<double>(lookAheadRevalidationPeriod_),
+                                     [this] { return lookAheadShutdown_ || lookAheadGoalsUpdated_; });
+
+        if (lookAheadShutdown_)
+            break;
+
+        if (lookAheadGoals_.size() < 2)
+        {
+            cachedPlans_.clear();
+            lookAheadGoalsUpdated_ = false;
+            continue;
+        }
+
+        lookAheadGoalsUpdated_ = false;
+        auto goals = lookAheadGoals_;
+        auto previousPlans = cachedPlans_;
+
+        // planning is done without blocking makePlan
+        lock.unlock();
+        auto plans = this->updateLookAheadPlans(goals, previousPlans);
+        lock.lock();
+
+        // a newer set of goals arrived meanwhile, these plans are outdated
+        if (!lookAheadGoalsUpdated_)
+        {
+            // the plans consumed by makePlan meanwhile are not restored
+            plans.erase(std::remove_if(plans.begin(), plans.end(), [&](const CachedPlan &p) {
+                            return containsGoal(previousPlans, p.goal) && !containsGoal(cachedPlans_, p.goal);
+                        }),
+                        plans.end());
+
+            cachedPlans_ = plans;
+        }
+    }
+}
+
+std::vector<ForwardGlobalPlanner::CachedPlan> ForwardGlobalPlanner::updateLookAheadPlans(const std::vector<geometry_msgs::PoseStamped> &goals,
+                                                                                         const std::vector<CachedPlan> &previousPlans)
+{
+    // the costmap is copied once, validation does not block the costmap updates
+    costmap_2d::Costmap2D snapshot;
+    {
+        costmap_2d::Costmap2D *costmap2d = this->costmap_ros_->getCostmap();
+        boost::unique_lock<costmap_2d::Costmap2D::mutex_t> lock(*(costmap2d->getMutex()));
+        snapshot = *costmap2d;
+    }
+
+    lookAheadValidator_.setFootprint(this->costmap_ros_->getRobotFootprint());
+
+    // the first goal is the one the robot is driving to, plans start from it
+    std::vector<CachedPlan> plans;
+    for (size_t i = 0; i + 1 < goals.size(); i++)
+    {
+        CachedPlan cached;
+        cached.start = goals[i];
+        cached.goal = goals[i + 1];
+
+        auto previous = std::find_if(previousPlans.begin(), previousPlans.end(), [&](const CachedPlan &p) {
+            return closePoses(p.start, cached.start, 1e-3, 1e-3) && closePoses(p.goal, cached.goal, 1e-3, 1e-3);
+        });
+
+        if (previous != previousPlans.end())
+            cached.plan = previous->plan;
+        else
+            this->generatePlan(cached.start, cached.goal, cached.plan);
+
+        int collisionIndex;
+        if (lookAheadValidator_.validate(snapshot, cached.plan, &collisionIndex))
+        {
+            plans.push_back(cached);
+        }
+        else
+        {
+            ROS_INFO("[Forward Global Planner] look-ahead plan to goal %lu discarded, collision at pose %d", i + 1, collisionIndex);
+        }
+    }
+
+    return plans;
+}
+
+bool ForwardGlobalPlanner::takeCachedPlan(const geometry_msgs::PoseStamped &start,
+                                          const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan)
+{
+    CachedPlan cached;
+    {
+        std::lock_guard<std::mutex> lock(lookAheadMutex_);
+        auto it = std::find_if(cachedPlans_.begin(), cachedPlans_.end(), [&](const CachedPlan &p) {
+            return closePoses(p.goal, goal, 1e-3, 1e-3) && closePoses(p.start, start, lookAheadStartTolerance_, M_PI);
+        });
+
+        if (it == cachedPlans_.end())
+            return false;
+
+        cached = *it;
+
+        // the robot now drives to this goal, the previous goals and their plans will not be requested anymore
+        auto current = std::find_if(lookAheadGoals_.begin(), lookAheadGoals_.end(), [&](const geometry_msgs::PoseStamped &g) {
+            return closePoses(g, goal, 1e-3, 1e-3);
+        });
+        lookAheadGoals_.erase(lookAheadGoals_.begin(), current);
+        cachedPlans_.erase(cachedPlans_.begin(), it + 1);
+    }
+
+    // the cached plan starts at the previous goal pose, not at the robot pose: the plan first spins and drives
+    // from the robot pose to the cached start (and aligns with its orientation), then follows the cached poses
+    plan.clear();
+    this->generatePlan(start, cached.start, plan);
+    plan.insert(plan.end(), cached.plan.begin(), cached.plan.end());
+    return true;
+}
+
 }; // namespace forward_global_planner
 } // namespace cl_move_base_z
 
@@ -7,6 +7,8 @@
 #include <geometry_msgs/PoseStamped.h>
 #include <tf/transform_datatypes.h>
 #include <angles/angles.h>
+#include <algorithm>
+#include <cmath>
    
 namespace cl_move_base_z
 {
@@ -86,4 +88,25 @@ namespace cl_move_base_z
     
         return plan.back();
     }
+
+    void sampleFootprintPerimeter(const std::vector<geometry_msgs::Point> &footprint, double resolution,
+                                  std::vector<float> &xs, std::vector<float> &ys)
+    {
+        xs.clear();
+        ys.clear();
+        for (size_t i = 0; i < footprint.size(); i++)
+        {
+            auto &a = footprint[i];
+            auto &b = footprint[(i + 1) % footprint.size()];
+
+            double dx = b.x - a.x;
+            double dy = b.y - a.y;
+            int n = std::max(1, (int)std::ceil(std::sqrt(dx * dx + dy * dy) / resolution));
+            for (int j = 0; j < n; j++)
+            {
+                xs.push_back(a.x + dx * j / n);
+                ys.push_back(a.y + dy * j / n);
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <forward_global_planner/plan_validator.h>
+#include <forward_global_planner/move_base_z_client_tools.h>
+#include <costmap_2d/cost_values.h>
+#include <tf/transform_datatypes.h>
+#include <angles/angles.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cl_move_base_z
+{
+PlanValidator::PlanValidator()
+    : perimeterResolution_(0), footprintRadius_(0)
+{
+}
+
+void PlanValidator::setFootprint(const std::vector<geometry_msgs::Point> &footprint)
+{
+    footprint_ = footprint;
+    perimeterResolution_ = 0;
+
+    footprintRadius_ = 0;
+    for (auto &p : footprint_)
+    {
+        footprintRadius_ = std::max(footprintRadius_, std::sqrt(p.x * p.x + p.y * p.y));
+    }
+}
+
+bool PlanValidator::validate(costmap_2d::Costmap2D &costmap, const std::vector<geometry_msgs::PoseStamped> &plan,
+                             int *collisionIndex)
+{
+    if (collisionIndex != nullptr)
+        *collisionIndex = -1;
+
+    if (plan.size() < 2)
+        return true;
+
+    boost::unique_lock<costmap_2d::Costmap2D::mutex_t> lock(*(costmap.getMutex()));
+
+    const unsigned char *grid = costmap.getCharMap();
+    int sizeX = costmap.getSizeInCellsX();
+    int sizeY = costmap.getSizeInCellsY();
+    double originX = costmap.getOriginX();
+    double originY = costmap.getOriginY();
+    double resolution = costmap.getResolution();
+
+    if (resolution != perimeterResolution_)
+    {
+        sampleFootprintPerimeter(footprint_, resolution, perimeterX_, perimeterY_);
+        perimeterResolution_ = resolution;
+    }
+
+    // cells outside the costmap are not checked, the costmap does not know about them
+    auto cellCost = [&](int mx, int my) -> int {
+        if (mx < 0 || my < 0 || mx >= sizeX || my >= sizeY)
+            return -1;
+        return grid[my * sizeX + mx];
+    };
+
+    auto footprintCollides = [&](double x, double y, double yaw) {
+        double c = std::cos(yaw);
+        double s = std::sin(yaw);
+        for (size_t i = 0; i < perimeterX_.size(); i++)
+        {
+            double wx = x + perimeterX_[i] * c - perimeterY_[i] * s;
+            double wy = y + perimeterX_[i] * s + perimeterY_[i] * c;
+            int mx = (int)std::floor((wx - originX) / resolution);
+            int my = (int)std::floor((wy - originY) / resolution);
+            if (cellCost(mx, my) >= costmap_2d::LETHAL_OBSTACLE)
+                return true;
+        }
+        return false;
+    };
+
+    // the robot is at the first pose: its cell and its footprint at that pose are not checked, also where the plan
+    // repeats it (ie: a plan that spins in place or a [start, start] plan)
+    auto &startPose = plan.front().pose;
+    int startCellX = (int)std::floor((startPose.position.x - originX) / resolution);
+    int startCellY = (int)std::floor((startPose.position.y - originY) / resolution);
+    double startYaw = tf::getYaw(startPose.orientation);
+
+    auto isStartPose = [&](double x, double y, double yaw) {
+        return std::fabs(x - startPose.position.x) < 1e-6 && std::fabs(y - startPose.position.y) < 1e-6 &&
+               std::fabs(angles::shortest_angular_distance(yaw, startYaw)) < 1e-6;
+    };
+
+    for (size_t i = 0; i + 1 < plan.size(); i++)
+    {
+        auto &a = plan[i].pose;
+        auto &b = plan[i + 1].pose;
+
+        // ------ centre line: DDA over every cell crossed by the segment ------
+        double ax = (a.position.x - originX) / resolution;
+        double ay = (a.position.y - originY) / resolution;
+        double bx = (b.position.x - originX) / resolution;
+        double by = (b.position.y - originY) / resolution;
+
+        int cx = (int)std::floor(ax);
+        int cy = (int)std::floor(ay);
+        int endX = (int)std::floor(bx);
+        int endY = (int)std::floor(by);
+
+        double dx = bx - ax;
+        double dy = by - ay;
+        int stepX = dx > 0 ? 1 : -1;
+        int stepY = dy > 0 ? 1 : -1;
+        double tDeltaX = dx != 0 ? std::fabs(1.0 / dx) : std::numeric_limits<double>::max();
+        double tDeltaY = dy != 0 ? std::fabs(1.0 / dy) : std::numeric_limits<double>::max();
+        double tMaxX = dx != 0 ? ((dx > 0 ? (cx + 1 - ax) : (ax - cx)) * tDeltaX) : std::numeric_limits<double>::max();
+        double tMaxY = dy != 0 ? ((dy > 0 ? (cy + 1 - ay) : (ay - cy)) * tDeltaY) : std::numeric_limits<double>::max();
+
+        int maxCells = std::abs(endX - cx) + std::abs(endY - cy) + 1;
+        for (int n = 0; n < maxCells; n++)
+        {
+            bool startCell = cx == startCellX && cy == startCellY;
+            if (!startCell && cellCost(cx, cy) >= costmap_2d::INSCRIBED_INFLATED_OBSTACLE)
+            {
+                if (collisionIndex != nullptr)
+                    *collisionIndex = i;
+                return false;
+            }
+
+            if (tMaxX < tMaxY)
+            {
+                tMaxX += tDeltaX;
+                cx += stepX;
+            }
+            else
+            {
+                tMaxY += tDeltaY;
+                cy += stepY;
+            }
+        }
+
+        // ------ footprint swept along the segment ------
+        if (perimeterX_.empty())
+            continue;
+
+        double yawA = tf::getYaw(a.orientation);
+        double dyaw = angles::shortest_angular_distance(yawA, tf::getYaw(b.orientation));
+        double length = std::sqrt(dx * dx + dy * dy); // cells
+
+        // the perimeter moves at most one cell between samples
+        int samples = std::max(1, (int)std::ceil(std::max(length, std::fabs(dyaw) * footprintRadius_ / resolution)));
+        for (int k = 0; k <= samples; k++)
+        {
+            double t = (double)k / samples;
+            double x = a.position.x + (b.position.x - a.position.x) * t;
+            double y = a.position.y + (b.position.y - a.position.y) * t;
+            double yaw = yawA + dyaw * t;
+            if (!isStartPose(x, y, yaw) && footprintCollides(x, y, yaw))
+            {
+                if (collisionIndex != nullptr)
+                    *collisionIndex = i;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+} // namespace cl_move_base_z
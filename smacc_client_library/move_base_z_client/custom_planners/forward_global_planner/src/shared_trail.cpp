@@ -0,0 +1,329 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <forward_global_planner/shared_trail.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace cl_move_base_z
+{
+using namespace boost::interprocess;
+
+static const uint32_t SHARED_TRAIL_MAGIC = 0x5452414c; // "TRAL"
+static const size_t SHARED_TRAIL_FRAME_ID_SIZE = 64;
+
+struct SharedTrailHeader
+{
+    uint32_t magic;
+
+    // set to false by the writer when the segment is replaced, readers must reopen it
+    std::atomic<uint32_t> valid;
+
+    // seqlock: odd while the writer is modifying the trail
+    std::atomic<uint64_t> version;
+
+    uint64_t capacity;
+    uint64_t start;
+    uint64_t count;
+    char frameId[SHARED_TRAIL_FRAME_ID_SIZE];
+};
+
+struct SharedTrailPose
+{
+    double x, y, z;
+    double qx, qy, qz, qw;
+    uint32_t sec, nsec;
+};
+
+std::string getDefaultSharedTrailName()
+{
+    std::string name = "smacc_odom_tracker_trail" + ros::this_node::getNamespace();
+    for (auto &c : name)
+    {
+        if (c == '/')
+            c = '_';
+    }
+    return name;
+}
+
+/**
+******************************************************************************************************************
+* SharedTrailWriter
+******************************************************************************************************************
+*/
+SharedTrailWriter::SharedTrailWriter(const std::string &name, size_t capacity)
+    : name_(name)
+{
+    size_t size = sizeof(SharedTrailHeader) + capacity * sizeof(SharedTrailPose);
+
+    {
+        // a segment of a previous execution is reused if it has the same layout, otherwise it is replaced
+        shared_memory_object existing(open_or_create, name_.c_str(), read_write);
+        offset_t existingSize = 0;
+        existing.get_size(existingSize);
+
+        if (existingSize != 0 && existingSize != (offset_t)size)
+        {
+            mapped_region oldRegion(existing, read_write);
+            auto *oldHeader = static_cast<SharedTrailHeader *>(oldRegion.get_address());
+            oldHeader->valid = 0;
+            shared_memory_object::remove(name_.c_str());
+        }
+    }
+
+    shm_ = shared_memory_object(open_or_create, name_.c_str(), read_write);
+    shm_.truncate(size);
+    region_ = mapped_region(shm_, read_write);
+
+    header_ = static_cast<SharedTrailHeader *>(region_.get_address());
+    poses_ = reinterpret_cast<SharedTrailPose *>(header_ + 1);
+
+    // a previous writer could have died in the middle of a modification
+    if (header_->version.load() % 2 == 1)
+    {
+        header_->version.fetch_add(1);
+    }
+
+    // the readers keep the last version they read when the segment is recreated: the versions of a new segment
+    // start from a value unique to this creation (wall time), not from 0
+    uint64_t firstVersion = ros::WallTime::now().toNSec() & ~(uint64_t)1;
+    if (header_->version.load() < firstVersion)
+    {
+        header_->version.store(firstVersion);
+    }
+
+    beginWrite();
+    header_->magic = SHARED_TRAIL_MAGIC;
+    header_->capacity = capacity;
+    header_->start = 0;
+    header_->count = 0;
+    header_->frameId[0] = '\0';
+    header_->valid = 1;
+    endWrite();
+
+    ROS_INFO_STREAM("[SharedTrailWriter] shared memory trail '" << name_ << "' created, capacity: " << capacity << " poses");
+}
+
+SharedTrailWriter::~SharedTrailWriter()
+{
+    // the readers that still map the segment must not take it as a live trail
+    header_->valid = 0;
+    shared_memory_object::remove(name_.c_str());
+}
+
+void SharedTrailWriter::beginWrite()
+{
+    header_->version.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void SharedTrailWriter::endWrite()
+{
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->version.fetch_add(1);
+}
+
+void SharedTrailWriter::writePose(size_t slot, const geometry_msgs::PoseStamped &pose)
+{
+    auto &dst = poses_[slot];
+    dst.x = pose.pose.position.x;
+    dst.y = pose.pose.position.y;
+    dst.z = pose.pose.position.z;
+    dst.qx = pose.pose.orientation.x;
+    dst.qy = pose.pose.orientation.y;
+    dst.qz = pose.pose.orientation.z;
+    dst.qw = pose.pose.orientation.w;
+    dst.sec = pose.header.stamp.sec;
+    dst.nsec = pose.header.stamp.nsec;
+}
+
+void SharedTrailWriter::append(const geometry_msgs::PoseStamped &pose)
+{
+    bool truncated = false;
+    beginWrite();
+    auto capacity = header_->capacity;
+    if (capacity > 0)
+    {
+        if (header_->count < capacity)
+        {
+            writePose((header_->start + header_->count) % capacity, pose);
+            header_->count++;
+        }
+        else
+        {
+            // full, the oldest pose is overwritten
+            writePose(header_->start, pose);
+            header_->start = (header_->start + 1) % capacity;
+            truncated = true;
+        }
+    }
+    endWrite();
+
+    if (truncated)
+        warnTruncated();
+}
+
+void SharedTrailWriter::removeLast()
+{
+    beginWrite();
+    if (header_->count > 0)
+    {
+        header_->count--;
+    }
+    endWrite();
+}
+
+void SharedTrailWriter::reset(const std::vector<geometry_msgs::PoseStamped> &poses)
+{
+    beginWrite();
+    auto capacity = header_->capacity;
+    size_t first = poses.size() > capacity ? poses.size() - capacity : 0;
+
+    header_->start = 0;
+    header_->count = poses.size() - first;
+    for (size_t i = first; i < poses.size(); i++)
+    {
+        writePose(i - first, poses[i]);
+    }
+    endWrite();
+
+    if (first > 0)
+        warnTruncated();
+}
+
+void SharedTrailWriter::warnTruncated()
+{
+    ROS_WARN_STREAM_THROTTLE(10, "[SharedTrailWriter] the trail is longer than the shared memory trail '" << name_
+                                     << "', only its last " << header_->capacity << " poses are shared");
+}
+
+void SharedTrailWriter::setFrameId(const std::string &frameId)
+{
+    if (frameId == header_->frameId)
+        return;
+
+    beginWrite();
+    strncpy(header_->frameId, frameId.c_str(), SHARED_TRAIL_FRAME_ID_SIZE - 1);
+    header_->frameId[SHARED_TRAIL_FRAME_ID_SIZE - 1] = '\0';
+    endWrite();
+}
+
+/**
+******************************************************************************************************************
+* SharedTrailReader
+******************************************************************************************************************
+*/
+SharedTrailReader::SharedTrailReader(const std::string &name)
+    : name_(name), header_(nullptr), poses_(nullptr), capacity_(0)
+{
+}
+
+bool SharedTrailReader::open()
+{
+    try
+    {
+        shm_.reset(new shared_memory_object(open_only, name_.c_str(), read_only));
+        region_.reset(new mapped_region(*shm_, read_only));
+    }
+    catch (const interprocess_exception &)
+    {
+        // the writer did not create it yet
+        region_.reset();
+        shm_.reset();
+        return false;
+    }
+
+    if (region_->get_size() < sizeof(SharedTrailHeader))
+    {
+        region_.reset();
+        shm_.reset();
+        return false;
+    }
+
+    header_ = static_cast<const SharedTrailHeader *>(region_->get_address());
+    poses_ = reinterpret_cast<const SharedTrailPose *>(header_ + 1);
+
+    if (header_->magic != SHARED_TRAIL_MAGIC || !header_->valid ||
+        region_->get_size() < sizeof(SharedTrailHeader) + header_->capacity * sizeof(SharedTrailPose))
+    {
+        header_ = nullptr;
+        poses_ = nullptr;
+        region_.reset();
+        shm_.reset();
+        return false;
+    }
+
+    // the capacity of a segment never changes, the rest of the header is only trusted after the seqlock check
+    capacity_ = header_->capacity;
+
+    ROS_INFO_STREAM("[SharedTrailReader] shared memory trail '" << name_ << "' opened");
+    return true;
+}
+
+bool SharedTrailReader::readIfUpdated(nav_msgs::Path &path, uint64_t &lastVersion)
+{
+    if (header_ == nullptr || !header_->valid)
+    {
+        header_ = nullptr;
+        if (!open())
+            return false;
+    }
+
+    std::vector<SharedTrailPose> poses;
+    std::string frameId;
+    uint64_t version;
+
+    while (true)
+    {
+        version = header_->version.load(std::memory_order_acquire);
+        if (version == lastVersion)
+            return false;
+
+        if (version % 2 == 1)
+        {
+            // the writer is modifying it
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint64_t start = header_->start % std::max<uint64_t>(capacity_, 1);
+        uint64_t count = std::min<uint64_t>(header_->count, capacity_);
+        frameId = std::string(header_->frameId, strnlen(header_->frameId, SHARED_TRAIL_FRAME_ID_SIZE));
+
+        poses.resize(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            poses[i] = poses_[(start + i) % capacity_];
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header_->version.load(std::memory_order_relaxed) == version)
+            break;
+    }
+
+    path.header.frame_id = frameId;
+    path.header.stamp = ros::Time::now();
+    path.poses.resize(poses.size());
+    for (size_t i = 0; i < poses.size(); i++)
+    {
+        auto &src = poses[i];
+        auto &dst = path.poses[i];
+        dst.header.frame_id = frameId;
+        dst.header.stamp = ros::Time(src.sec, src.nsec);
+        dst.pose.position.x = src.x;
+        dst.pose.position.y = src.y;
+        dst.pose.position.z = src.z;
+        dst.pose.orientation.x = src.qx;
+        dst.pose.orientation.y = src.qy;
+        dst.pose.orientation.z = src.qz;
+        dst.pose.orientation.w = src.qw;
+    }
+
+    lastVersion = version;
+    return true;
+}
+} // namespace cl_move_base_z
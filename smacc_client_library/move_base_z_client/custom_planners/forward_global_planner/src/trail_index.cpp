@@ -0,0 +1,149 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <forward_global_planner/trail_index.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cl_move_base_z
+{
+TrailIndex::TrailIndex(double cellSize)
+    : cellSize_(cellSize)
+{
+    clear();
+}
+
+void TrailIndex::clear()
+{
+    points_.clear();
+    cells_.clear();
+    bounds_.reset();
+}
+
+void TrailIndex::append(double x, double y)
+{
+    int cx = cellCoord(x);
+    int cy = cellCoord(y);
+
+    cells_[gridCellKey(cx, cy)].push_back(points_.size());
+    points_.push_back({x, y});
+    bounds_.expand(cx, cy);
+}
+
+void TrailIndex::removeLast()
+{
+    if (points_.empty())
+        return;
+
+    auto &p = points_.back();
+    auto it = cells_.find(gridCellKey(cellCoord(p.x), cellCoord(p.y)));
+
+    // indexes are appended in order, so the last one is at the end of its cell
+    it->second.pop_back();
+    if (it->second.empty())
+    {
+        cells_.erase(it);
+    }
+
+    points_.pop_back();
+}
+
+void TrailIndex::sync(const std::vector<geometry_msgs::PoseStamped> &trail)
+{
+    size_t indexed = points_.size();
+    bool grown = indexed <= trail.size();
+    if (grown && indexed > 0)
+    {
+        auto &first = trail.front().pose.position;
+        auto &last = trail[indexed - 1].pose.position;
+        grown = first.x == points_.front().x && first.y == points_.front().y &&
+                last.x == points_.back().x && last.y == points_.back().y;
+    }
+
+    if (!grown)
+    {
+        clear();
+        indexed = 0;
+    }
+
+    for (size_t i = indexed; i < trail.size(); i++)
+    {
+        auto &p = trail[i].pose.position;
+        append(p.x, p.y);
+    }
+}
+
+int TrailIndex::nearest(double x, double y) const
+{
+    if (points_.empty())
+        return -1;
+
+    int best = -1;
+    double bestDist2 = std::numeric_limits<double>::max();
+
+    auto visitCell = [&](int i, int j) {
+        auto it = cells_.find(gridCellKey(i, j));
+        if (it == cells_.end())
+            return;
+
+        for (int index : it->second)
+        {
+            double dx = points_[index].x - x;
+            double dy = points_[index].y - y;
+            double d2 = dx * dx + dy * dy;
+            if (d2 < bestDist2 || (d2 == bestDist2 && index < best))
+            {
+                best = index;
+                bestDist2 = d2;
+            }
+        }
+    };
+
+    // the points of the ring r are at least (r-1) cells away from the query point
+    auto closerThanRing = [&](int r) {
+        double ringDist = (r - 1) * cellSize_;
+        return best != -1 && r > 0 && ringDist * ringDist > bestDist2;
+    };
+
+    visitCellRings(cellCoord(x), cellCoord(y), bounds_, visitCell, closerThanRing);
+    return best;
+}
+
+void TrailIndex::radiusSearch(double x, double y, double radius, std::vector<int> &indexes) const
+{
+    indexes.clear();
+    if (points_.empty())
+        return;
+
+    double radius2 = radius * radius;
+    int minCx = std::max(cellCoord(x - radius), bounds_.minX);
+    int maxCx = std::min(cellCoord(x + radius), bounds_.maxX);
+    int minCy = std::max(cellCoord(y - radius), bounds_.minY);
+    int maxCy = std::min(cellCoord(y + radius), bounds_.maxY);
+
+    for (int i = minCx; i <= maxCx; i++)
+    {
+        for (int j = minCy; j <= maxCy; j++)
+        {
+            auto it = cells_.find(gridCellKey(i, j));
+            if (it == cells_.end())
+                continue;
+
+            for (int index : it->second)
+            {
+                double dx = points_[index].x - x;
+                double dy = points_[index].y - y;
+                if (dx * dx + dy * dy < radius2)
+                {
+                    indexes.push_back(index);
+                }
+            }
+        }
+    }
+
+    std::sort(indexes.begin(), indexes.end());
+}
+} // namespace cl_move_base_z
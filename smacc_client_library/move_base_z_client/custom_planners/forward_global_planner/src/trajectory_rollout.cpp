@@ -0,0 +1,197 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <forward_global_planner/trajectory_rollout.h>
+#include <forward_global_planner/move_base_z_client_tools.h>
+#include <costmap_2d/cost_values.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cl_move_base_z
+{
+TrajectoryRollout::TrajectoryRollout()
+    : lastResolution_(0)
+{
+    configure(0.05, 3.0);
+}
+
+void TrajectoryRollout::configure(float dt, float maxTime)
+{
+    dt_ = dt;
+    steps_ = std::max(1, (int)std::ceil(maxTime / dt));
+}
+
+void TrajectoryRollout::setFootprint(const std::vector<geometry_msgs::Point> &footprint, double resolution)
+{
+    auto samePoint = [](const geometry_msgs::Point &a, const geometry_msgs::Point &b) { return a.x == b.x && a.y == b.y; };
+    if (resolution == lastResolution_ && footprint.size() == lastFootprint_.size() &&
+        std::equal(footprint.begin(), footprint.end(), lastFootprint_.begin(), samePoint))
+        return;
+
+    lastFootprint_ = footprint;
+    lastResolution_ = resolution;
+
+    std::vector<float> px, py;
+    sampleFootprintPerimeter(footprint, resolution, px, py);
+
+    footprintX_ = Eigen::Map<Eigen::ArrayXf>(px.data(), px.size());
+    footprintY_ = Eigen::Map<Eigen::ArrayXf>(py.data(), py.size());
+}
+
+void TrajectoryRollout::simulate(const Eigen::Vector3f &pose, const std::vector<Eigen::Vector3f> &samples)
+{
+    int count = samples.size();
+
+    // eigen only reallocates if the size changes
+    x_.resize(count, steps_ + 1);
+    y_.resize(count, steps_ + 1);
+    theta_.resize(count, steps_ + 1);
+    vx_.resize(count);
+    vy_.resize(count);
+    wz_.resize(count);
+    collisionStep_.assign(count, -1);
+
+    for (int k = 0; k < count; k++)
+    {
+        vx_(k) = samples[k][0];
+        vy_(k) = samples[k][1];
+        wz_(k) = samples[k][2];
+    }
+
+    x_.col(0).setConstant(pose[0]);
+    y_.col(0).setConstant(pose[1]);
+    theta_.col(0).setConstant(pose[2]);
+
+    for (int s = 0; s < steps_; s++)
+    {
+        cos_ = theta_.col(s).cos();
+        sin_ = theta_.col(s).sin();
+
+        x_.col(s + 1) = x_.col(s) + (vx_ * cos_ - vy_ * sin_) * dt_;
+        y_.col(s + 1) = y_.col(s) + (vx_ * sin_ + vy_ * cos_) * dt_;
+        theta_.col(s + 1) = theta_.col(s) + wz_ * dt_;
+    }
+}
+
+void TrajectoryRollout::checkCollisions(costmap_2d::Costmap2D &costmap, float goalX, float goalY, float goalTolerance)
+{
+    boost::unique_lock<costmap_2d::Costmap2D::mutex_t> lock(*(costmap.getMutex()));
+
+    const unsigned char *grid = costmap.getCharMap();
+    int sizeX = costmap.getSizeInCellsX();
+    int sizeY = costmap.getSizeInCellsY();
+    float originX = costmap.getOriginX();
+    float originY = costmap.getOriginY();
+    float invResolution = 1.0 / costmap.getResolution();
+    float goalTolerance2 = goalTolerance * goalTolerance;
+
+    // cells outside the costmap are not checked, the costmap does not know about them
+    auto cellCost = [&](float wx, float wy) -> int {
+        int mx = (int)std::floor((wx - originX) * invResolution);
+        int my = (int)std::floor((wy - originY) * invResolution);
+        if (mx < 0 || my < 0 || mx >= sizeX || my >= sizeY)
+            return -1;
+        return grid[my * sizeX + mx];
+    };
+
+    for (int k = 0; k < samples(); k++)
+    {
+        for (int s = 1; s <= steps_; s++)
+        {
+            float px = x_(k, s);
+            float py = y_(k, s);
+
+            float gdx = px - goalX;
+            float gdy = py - goalY;
+            if (gdx * gdx + gdy * gdy < goalTolerance2)
+                break;
+
+            // the inflation already accounts for the inscribed radius of the robot
+            if (cellCost(px, py) >= costmap_2d::INSCRIBED_INFLATED_OBSTACLE)
+            {
+                collisionStep_[k] = s;
+                break;
+            }
+
+            if (footprintX_.size() > 0)
+            {
+                float c = std::cos(theta_(k, s));
+                float sn = std::sin(theta_(k, s));
+                worldX_ = px + footprintX_ * c - footprintY_ * sn;
+                worldY_ = py + footprintX_ * sn + footprintY_ * c;
+
+                bool collision = false;
+                for (int i = 0; i < worldX_.size() && !collision; i++)
+                {
+                    collision = cellCost(worldX_(i), worldY_(i)) >= costmap_2d::LETHAL_OBSTACLE;
+                }
+
+                if (collision)
+                {
+                    collisionStep_[k] = s;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void TrajectoryRollout::getTrajectory(int sample, std::vector<Eigen::Vector3f> &trajectory) const
+{
+    trajectory.resize(steps_);
+    for (int s = 1; s <= steps_; s++)
+    {
+        trajectory[s - 1] = Eigen::Vector3f(x_(sample, s), y_(sample, s), theta_(sample, s));
+    }
+}
+
+int TrajectoryRollout::getBestCollisionFreeSample(const Eigen::Vector3f &nominal, float maxLinearSpeed, float maxAngularSpeed) const
+{
+    int best = -1;
+    float bestScore = std::numeric_limits<float>::max();
+    float linearScale = maxLinearSpeed > 0 ? 1.0 / maxLinearSpeed : 1.0;
+    float angularScale = maxAngularSpeed > 0 ? 1.0 / maxAngularSpeed : 1.0;
+
+    for (int k = 0; k < samples(); k++)
+    {
+        if (!isCollisionFree(k))
+            continue;
+
+        float score = std::fabs(vx_(k) - nominal[0]) * linearScale + std::fabs(vy_(k) - nominal[1]) * linearScale +
+                      std::fabs(wz_(k) - nominal[2]) * angularScale;
+        if (score < bestScore)
+        {
+            best = k;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+void TrajectoryRollout::sampleCommands(const Eigen::Vector3f &nominal, float maxLinearSpeed, float maxAngularSpeed,
+                                       std::vector<Eigen::Vector3f> &samples)
+{
+    static const float linearFactors[] = {1.0, 0.75, 0.5, 0.25};
+    static const float angularOffsets[] = {0, -0.25, 0.25, -0.5, 0.5};
+
+    samples.clear();
+    samples.push_back(nominal);
+
+    for (float linearFactor : linearFactors)
+    {
+        for (float angularOffset : angularOffsets)
+        {
+            if (linearFactor == 1.0 && angularOffset == 0)
+                continue;
+
+            float wz = nominal[2] + angularOffset * maxAngularSpeed;
+            wz = std::max(-maxAngularSpeed, std::min(maxAngularSpeed, wz));
+            samples.push_back(Eigen::Vector3f(nominal[0] * linearFactor, nominal[1] * linearFactor, wz));
+        }
+    }
+}
+} // namespace cl_move_base_z
@@ -0,0 +1,82 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <forward_global_planner/plan_validator.h>
+#include <costmap_2d/cost_values.h>
+#include <tf/transform_datatypes.h>
+#include <gtest/gtest.h>
+
+using namespace cl_move_base_z;
+
+geometry_msgs::PoseStamped makePose(double x, double y, double yaw)
+{
+  geometry_msgs::PoseStamped pose;
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  pose.pose.orientation = tf::createQuaternionMsgFromYaw(yaw);
+  return pose;
+}
+
+geometry_msgs::Point makePoint(double x, double y)
+{
+  geometry_msgs::Point point;
+  point.x = x;
+  point.y = y;
+  return point;
+}
+
+// 5x5 meters costmap with 0.05 resolution and a 0.4x0.4 meters square robot
+class PlanValidatorTest : public testing::Test
+{
+protected:
+  PlanValidatorTest() : costmap(100, 100, 0.05, 0.0, 0.0)
+  {
+    validator.setFootprint({makePoint(0.2, 0.2), makePoint(-0.2, 0.2), makePoint(-0.2, -0.2), makePoint(0.2, -0.2)});
+  }
+
+  costmap_2d::Costmap2D costmap;
+  PlanValidator validator;
+};
+
+TEST_F(PlanValidatorTest, degeneratePlanAtTheRobotPose)
+{
+  // the robot is inflated and its footprint touches an obstacle: it can not be rejected for being where it is
+  costmap.setCost(20, 20, costmap_2d::INSCRIBED_INFLATED_OBSTACLE);
+  for (int j = 18; j <= 22; j++)
+  {
+    costmap.setCost(23, j, costmap_2d::LETHAL_OBSTACLE);
+    costmap.setCost(24, j, costmap_2d::LETHAL_OBSTACLE);
+  }
+
+  auto start = makePose(1.0, 1.0, 0);
+  int collisionIndex;
+  EXPECT_TRUE(validator.validate(costmap, {start, start}, &collisionIndex));
+  EXPECT_EQ(collisionIndex, -1);
+
+  EXPECT_TRUE(validator.validate(costmap, {start, start, start}));
+
+  // leaving the start pose towards the obstacle collides
+  EXPECT_FALSE(validator.validate(costmap, {start, start, makePose(2.0, 1.0, 0)}, &collisionIndex));
+  EXPECT_EQ(collisionIndex, 1);
+}
+
+TEST_F(PlanValidatorTest, spinningAtTheRobotPose)
+{
+  // out of the footprint at the start pose, reached by its corners when it turns
+  costmap.setCost(25, 20, costmap_2d::LETHAL_OBSTACLE);
+
+  auto start = makePose(1.0, 1.0, 0);
+  EXPECT_TRUE(validator.validate(costmap, {start, start}));
+
+  int collisionIndex;
+  EXPECT_FALSE(validator.validate(costmap, {start, start, makePose(1.0, 1.0, M_PI / 2)}, &collisionIndex));
+  EXPECT_EQ(collisionIndex, 1);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <forward_global_planner/trail_index.h>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace cl_move_base_z;
+
+geometry_msgs::PoseStamped makePose(double x, double y)
+{
+  geometry_msgs::PoseStamped pose;
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  pose.pose.orientation.w = 1;
+  return pose;
+}
+
+// reference implementation: linear scan, lowest index on ties
+int bruteForceNearest(const std::vector<geometry_msgs::PoseStamped> &trail, double x, double y)
+{
+  int best = -1;
+  double bestDistance = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < trail.size(); i++)
+  {
+    double dx = trail[i].pose.position.x - x;
+    double dy = trail[i].pose.position.y - y;
+    double distance = dx * dx + dy * dy;
+    if (distance < bestDistance)
+    {
+      bestDistance = distance;
+      best = i;
+    }
+  }
+  return best;
+}
+
+std::vector<int> bruteForceRadius(const std::vector<geometry_msgs::PoseStamped> &trail, double x, double y, double radius)
+{
+  std::vector<int> indexes;
+  for (size_t i = 0; i < trail.size(); i++)
+  {
+    double dx = trail[i].pose.position.x - x;
+    double dy = trail[i].pose.position.y - y;
+    if (dx * dx + dy * dy < radius * radius)
+      indexes.push_back(i);
+  }
+  return indexes;
+}
+
+TEST(TrailIndexTest, queriesMatchTheLinearScan)
+{
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> inside(-50, 50);
+  std::uniform_real_distribution<double> around(-60, 60);
+
+  std::vector<geometry_msgs::PoseStamped> trail;
+  TrailIndex index(0.3);
+  for (int i = 0; i < 3000; i++)
+  {
+    trail.push_back(makePose(inside(random), inside(random)));
+
+    // the trail grows between syncs, only the new poses are indexed
+    if (i % 7 == 0)
+      index.sync(trail);
+  }
+  index.sync(trail);
+  ASSERT_EQ(index.size(), trail.size());
+
+  for (int q = 0; q < 500; q++)
+  {
+    double x = around(random);
+    double y = around(random);
+
+    EXPECT_EQ(index.nearest(x, y), bruteForceNearest(trail, x, y));
+
+    std::vector<int> indexes;
+    index.radiusSearch(x, y, 3.0, indexes);
+    EXPECT_EQ(indexes, bruteForceRadius(trail, x, y, 3.0));
+  }
+}
+
+TEST(TrailIndexTest, removeLastAndResync)
+{
+  std::vector<geometry_msgs::PoseStamped> trail;
+  for (int i = 0; i < 100; i++)
+    trail.push_back(makePose(i * 0.1, 0));
+
+  TrailIndex index;
+  index.sync(trail);
+
+  for (int i = 0; i < 30; i++)
+  {
+    index.removeLast();
+    trail.pop_back();
+  }
+
+  ASSERT_EQ(index.size(), 70);
+  EXPECT_EQ(index.nearest(100, 0), 69);
+
+  // a trail that did not only grow is rebuilt
+  std::vector<geometry_msgs::PoseStamped> other;
+  for (int i = 0; i < 10; i++)
+    other.push_back(makePose(0, i * 0.1));
+  index.sync(other);
+
+  ASSERT_EQ(index.size(), 10);
+  EXPECT_EQ(index.nearest(0, 100), 9);
+  EXPECT_EQ(index.nearest(5, 0), 0);
+}
+
+TEST(TrailIndexTest, replacedPlanWithTheSameLengthAndEnd)
+{
+  std::vector<geometry_msgs::PoseStamped> plan;
+  for (int i = 0; i < 50; i++)
+    plan.push_back(makePose(i * 0.1, 0));
+
+  TrailIndex index;
+  index.sync(plan);
+
+  // a new plan from another start to the same goal
+  std::vector<geometry_msgs::PoseStamped> newPlan;
+  for (int i = 0; i < 49; i++)
+    newPlan.push_back(makePose(i * 0.1, 3 - i * 3.0 / 49));
+  newPlan.push_back(plan.back());
+
+  index.sync(newPlan);
+  EXPECT_EQ(index.nearest(0, 3), 0);
+  EXPECT_EQ(index.nearest(0, 0), bruteForceNearest(newPlan, 0, 0));
+
+  std::vector<int> indexes;
+  index.radiusSearch(0, 0, 0.5, indexes);
+  EXPECT_EQ(indexes, bruteForceRadius(newPlan, 0, 0, 0.5));
+
+  // clear always rebuilds
+  index.clear();
+  index.sync(plan);
+  EXPECT_EQ(index.nearest(0, 0), 0);
+}
+
+TEST(TrailIndexTest, farQueries)
+{
+  std::vector<geometry_msgs::PoseStamped> trail;
+  for (int i = 0; i < 100; i++)
+    trail.push_back(makePose(i * 0.1, -5 + (i % 3) * 0.1));
+
+  TrailIndex index(0.01);
+  index.sync(trail);
+
+  // millions of cells away from the trail, in every direction
+  double far = 1e5;
+  for (auto query : {std::make_pair(far, 0.0), std::make_pair(-far, 0.0), std::make_pair(0.0, far),
+                     std::make_pair(0.0, -far), std::make_pair(far, -far)})
+  {
+    EXPECT_EQ(index.nearest(query.first, query.second), bruteForceNearest(trail, query.first, query.second));
+  }
+}
+
+TEST(TrailIndexTest, emptyIndex)
+{
+  TrailIndex index;
+  EXPECT_EQ(index.nearest(0, 0), -1);
+
+  std::vector<int> indexes;
+  index.radiusSearch(0, 0, 10, indexes);
+  EXPECT_TRUE(indexes.empty());
+
+  index.append(1, 1);
+  index.clear();
+  EXPECT_EQ(index.size(), 0);
+  EXPECT_EQ(index.nearest(1, 1), -1);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
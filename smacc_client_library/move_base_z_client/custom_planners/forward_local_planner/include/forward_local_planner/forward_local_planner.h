@@ -11,6 +11,7 @@
 #include <tf/transform_listener.h>
 #include <tf2_ros/buffer.h>
 #include <Eigen/Eigen>
+#include <forward_global_planner/trajectory_rollout.h>
 
 typedef double meter;
 typedef double rad;
@@ -83,8 +84,12 @@ private:
     double max_angular_z_speed_;
     double max_linear_x_speed_;
 
-    void generateTrajectory(const Eigen::Vector3f &pos, const Eigen::Vector3f &vel, float maxdist, float maxangle, float maxtime, float dt, std::vector<Eigen::Vector3f> &outtraj);
-    Eigen::Vector3f computeNewPositions(const Eigen::Vector3f &pos, const Eigen::Vector3f &vel, double dt);
+    // if the command of the controller collides, the closest collision free variant of it is used
+    bool enable_command_sampling_;
+
+    TrajectoryRollout rollout_;
+
+    std::vector<Eigen::Vector3f> commandSamples_;
 
     // references the current point inside the backwardsPlanPath were the robot is located
     int currentPoseIndex_;
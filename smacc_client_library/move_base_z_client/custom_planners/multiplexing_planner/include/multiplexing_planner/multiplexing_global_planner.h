@@ -0,0 +1,42 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <multiplexing_planner/planner_mode.h>
+#include <nav_core/base_global_planner.h>
+
+namespace cl_move_base_z
+{
+namespace multiplexing_planner
+{
+// Global planner that loads the forward/backward (and optionally the default) global planners once and
+// forwards every request to the planner of the current mode. Switching modes does not require
+// move_base to reload plugins or reset costmaps.
+//
+// parameters (~<name>/):
+//   planners: map mode -> global planner class
+//   initial_mode: mode used until the first planner_mode message arrives
+class MultiplexingGlobalPlanner : public nav_core::BaseGlobalPlanner
+{
+public:
+    MultiplexingGlobalPlanner();
+
+    virtual ~MultiplexingGlobalPlanner();
+
+    virtual void initialize(std::string name, costmap_2d::Costmap2DROS *costmap_ros) override;
+
+    virtual bool makePlan(const geometry_msgs::PoseStamped &start,
+                          const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan) override;
+
+    virtual bool makePlan(const geometry_msgs::PoseStamped &start,
+                          const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan,
+                          double &cost) override;
+
+private:
+    PlannerTable<nav_core::BaseGlobalPlanner> planners_;
+};
+} // namespace multiplexing_planner
+} // namespace cl_move_base_z
@@ -0,0 +1,58 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <multiplexing_planner/planner_mode.h>
+#include <nav_core/base_local_planner.h>
+#include <ros/common.h>
+
+#if ROS_VERSION_MINIMUM(1, 13, 0)
+#include <tf2_ros/buffer.h>
+#else
+#include <tf/transform_listener.h>
+#endif
+
+namespace cl_move_base_z
+{
+namespace multiplexing_planner
+{
+// Local planner that loads the forward, backward and pure spinning local planners once and forwards every
+// request to the planner of the current mode. When the mode changes, the last received plan is handed to the
+// new planner before it computes its first command.
+//
+// parameters (~<name>/):
+//   planners: map mode -> local planner class
+//   initial_mode: mode used until the first planner_mode message arrives
+class MultiplexingLocalPlanner : public nav_core::BaseLocalPlanner
+{
+public:
+    MultiplexingLocalPlanner();
+
+    virtual ~MultiplexingLocalPlanner();
+
+// MELODIC
+#if ROS_VERSION_MINIMUM(1, 13, 0)
+    virtual void initialize(std::string name, tf2_ros::Buffer *tf, costmap_2d::Costmap2DROS *costmap_ros) override;
+#else
+    // INDIGO AND PREVIOUS
+    virtual void initialize(std::string name, tf::TransformListener *tf, costmap_2d::Costmap2DROS *costmap_ros) override;
+#endif
+
+    virtual bool computeVelocityCommands(geometry_msgs::Twist &cmd_vel) override;
+
+    virtual bool isGoalReached() override;
+
+    virtual bool setPlan(const std::vector<geometry_msgs::PoseStamped> &plan) override;
+
+private:
+    nav_core::BaseLocalPlanner *getActivePlanner();
+
+    PlannerTable<nav_core::BaseLocalPlanner> planners_;
+
+    std::vector<geometry_msgs::PoseStamped> lastPlan_;
+};
+} // namespace multiplexing_planner
+} // namespace cl_move_base_z
@@ -0,0 +1,138 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <pluginlib/class_loader.h>
+#include <ros/ros.h>
+#include <std_msgs/String.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace cl_move_base_z
+{
+namespace multiplexing_planner
+{
+// Process wide planner mode ("forward", "backward", "pure_spinning", "default"...) shared by the
+// multiplexing global and local planners of a move_base node.
+// It is set from the latched "~planner_mode" topic or directly with setMode from the same process.
+// Every applied mode is published on the latched "~planner_mode_ack" topic: once a client receives the
+// ack of its mode, the goals it sends are planned with the planners of that mode.
+class PlannerModeSelector
+{
+public:
+    static PlannerModeSelector &getInstance();
+
+    void setMode(const std::string &mode);
+
+    std::string getMode() const;
+
+    // incremented in every mode change, it is cheap to poll from the planning loops
+    inline unsigned long getModeVersion() const
+    {
+        return version_.load(std::memory_order_acquire);
+    }
+
+    // subscribes to the mode topic and advertises the ack topic (only once, it is shared by the global and
+    // local planner)
+    void subscribe(ros::NodeHandle &nh, const std::string &initialMode);
+
+private:
+    PlannerModeSelector();
+
+    void onModeMsg(const std_msgs::String::ConstPtr &msg);
+
+    mutable std::mutex mutex_;
+
+    std::string mode_;
+
+    std::atomic<unsigned long> version_;
+
+    ros::Subscriber modeSub_;
+
+    ros::Publisher modeAckPub_;
+};
+
+// Set of planner plugins loaded once and indexed by planner mode.
+// Several modes may share the same planner class, in that case a single instance is created.
+template <typename TPlanner>
+class PlannerTable
+{
+public:
+    PlannerTable(const std::string &baseClass)
+        : loader_("nav_core", baseClass), modeVersion_(0)
+    {
+    }
+
+    // loads the planner classes of the mode -> class table. initializer receives the new instances
+    // and the name move_base would use for them
+    template <typename TInitializer>
+    void load(const std::map<std::string, std::string> &modePlanners, TInitializer initializer)
+    {
+        std::map<std::string, boost::shared_ptr<TPlanner>> instances;
+        for (auto &entry : modePlanners)
+        {
+            auto &className = entry.second;
+            auto it = instances.find(className);
+            if (it == instances.end())
+            {
+                try
+                {
+                    auto planner = loader_.createInstance(className);
+                    initializer(planner, loader_.getName(className));
+                    it = instances.insert(std::make_pair(className, planner)).first;
+                    ROS_INFO_STREAM("[MultiplexingPlanner] loaded planner " << className);
+                }
+                catch (const pluginlib::PluginlibException &ex)
+                {
+                    ROS_ERROR_STREAM("[MultiplexingPlanner] planner " << className << " for mode '" << entry.first << "' could not be loaded: " << ex.what());
+                    continue;
+                }
+            }
+
+            planners_[entry.first] = it->second;
+        }
+    }
+
+    // returns the planner of the current mode. changed is set when the mode changed since the last call
+    TPlanner *getActivePlanner(bool &changed)
+    {
+        auto &selector = PlannerModeSelector::getInstance();
+        auto version = selector.getModeVersion();
+        changed = false;
+
+        if (version != modeVersion_ || active_ == nullptr)
+        {
+            modeVersion_ = version;
+            auto mode = selector.getMode();
+            auto it = planners_.find(mode);
+            if (it != planners_.end())
+            {
+                changed = active_ != it->second.get();
+                active_ = it->second.get();
+                ROS_INFO_STREAM("[MultiplexingPlanner] planner mode: " << mode);
+            }
+            else
+            {
+                ROS_ERROR_STREAM("[MultiplexingPlanner] unknown planner mode '" << mode << "', keeping the previous planner");
+            }
+        }
+
+        return active_;
+    }
+
+private:
+    pluginlib::ClassLoader<TPlanner> loader_;
+
+    std::map<std::string, boost::shared_ptr<TPlanner>> planners_;
+
+    TPlanner *active_ = nullptr;
+
+    unsigned long modeVersion_;
+};
+} // namespace multiplexing_planner
+} // namespace cl_move_base_z
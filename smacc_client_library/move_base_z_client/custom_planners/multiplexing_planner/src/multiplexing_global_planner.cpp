@@ -0,0 +1,94 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <multiplexing_planner/multiplexing_global_planner.h>
+#include <pluginlib/class_list_macros.h>
+
+//register this planner as a BaseGlobalPlanner plugin
+PLUGINLIB_EXPORT_CLASS(cl_move_base_z::multiplexing_planner::MultiplexingGlobalPlanner, nav_core::BaseGlobalPlanner)
+
+namespace cl_move_base_z
+{
+namespace multiplexing_planner
+{
+/**
+******************************************************************************************************************
+* MultiplexingGlobalPlanner()
+******************************************************************************************************************
+*/
+MultiplexingGlobalPlanner::MultiplexingGlobalPlanner()
+    : planners_("nav_core::BaseGlobalPlanner")
+{
+}
+
+MultiplexingGlobalPlanner::~MultiplexingGlobalPlanner()
+{
+}
+
+/**
+******************************************************************************************************************
+* initialize()
+******************************************************************************************************************
+*/
+void MultiplexingGlobalPlanner::initialize(std::string name, costmap_2d::Costmap2DROS *costmap_ros)
+{
+    ROS_INFO("[MultiplexingGlobalPlanner] initializing");
+    ros::NodeHandle nh("~/" + name);
+
+    std::map<std::string, std::string> modePlanners;
+    if (!nh.getParam("planners", modePlanners))
+    {
+        modePlanners["forward"] = "forward_global_planner/ForwardGlobalPlanner";
+        modePlanners["backward"] = "backward_global_planner/BackwardGlobalPlanner";
+        modePlanners["pure_spinning"] = "forward_global_planner/ForwardGlobalPlanner";
+        modePlanners["default"] = "navfn/NavfnROS";
+    }
+
+    planners_.load(modePlanners, [&](boost::shared_ptr<nav_core::BaseGlobalPlanner> &planner, const std::string &plannerName) {
+        planner->initialize(plannerName, costmap_ros);
+    });
+
+    std::string initialMode;
+    nh.param<std::string>("initial_mode", initialMode, "default");
+
+    ros::NodeHandle private_nh("~");
+    PlannerModeSelector::getInstance().subscribe(private_nh, initialMode);
+}
+
+/**
+******************************************************************************************************************
+* makePlan()
+******************************************************************************************************************
+*/
+bool MultiplexingGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
+                                         const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan)
+{
+    bool changed;
+    auto planner = planners_.getActivePlanner(changed);
+    if (planner == nullptr)
+    {
+        ROS_ERROR("[MultiplexingGlobalPlanner] no planner available for the current mode");
+        return false;
+    }
+
+    return planner->makePlan(start, goal, plan);
+}
+
+bool MultiplexingGlobalPlanner::makePlan(const geometry_msgs::PoseStamped &start,
+                                         const geometry_msgs::PoseStamped &goal, std::vector<geometry_msgs::PoseStamped> &plan,
+                                         double &cost)
+{
+    bool changed;
+    auto planner = planners_.getActivePlanner(changed);
+    if (planner == nullptr)
+    {
+        ROS_ERROR("[MultiplexingGlobalPlanner] no planner available for the current mode");
+        return false;
+    }
+
+    return planner->makePlan(start, goal, plan, cost);
+}
+} // namespace multiplexing_planner
+} // namespace cl_move_base_z
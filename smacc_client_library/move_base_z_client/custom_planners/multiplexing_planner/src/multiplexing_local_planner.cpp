@@ -0,0 +1,136 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <multiplexing_planner/multiplexing_local_planner.h>
+#include <pluginlib/class_list_macros.h>
+
+//register this planner as a BaseLocalPlanner plugin
+PLUGINLIB_EXPORT_CLASS(cl_move_base_z::multiplexing_planner::MultiplexingLocalPlanner, nav_core::BaseLocalPlanner)
+
+namespace cl_move_base_z
+{
+namespace multiplexing_planner
+{
+/**
+******************************************************************************************************************
+* MultiplexingLocalPlanner()
+******************************************************************************************************************
+*/
+MultiplexingLocalPlanner::MultiplexingLocalPlanner()
+    : planners_("nav_core::BaseLocalPlanner")
+{
+}
+
+MultiplexingLocalPlanner::~MultiplexingLocalPlanner()
+{
+}
+
+/**
+******************************************************************************************************************
+* initialize()
+******************************************************************************************************************
+*/
+// MELODIC
+#if ROS_VERSION_MINIMUM(1, 13, 0)
+void MultiplexingLocalPlanner::initialize(std::string name, tf2_ros::Buffer *tf, costmap_2d::Costmap2DROS *costmap_ros)
+#else
+// INDIGO AND PREVIOUS
+void MultiplexingLocalPlanner::initialize(std::string name, tf::TransformListener *tf, costmap_2d::Costmap2DROS *costmap_ros)
+#endif
+{
+    ROS_INFO("[MultiplexingLocalPlanner] initializing");
+    ros::NodeHandle nh("~/" + name);
+
+    std::map<std::string, std::string> modePlanners;
+    if (!nh.getParam("planners", modePlanners))
+    {
+        modePlanners["forward"] = "forward_local_planner/ForwardLocalPlanner";
+        modePlanners["backward"] = "backward_local_planner/BackwardLocalPlanner";
+        modePlanners["pure_spinning"] = "pure_spinning_local_planner/PureSpinningLocalPlanner";
+        modePlanners["default"] = "base_local_planner/TrajectoryPlannerROS";
+    }
+
+    planners_.load(modePlanners, [&](boost::shared_ptr<nav_core::BaseLocalPlanner> &planner, const std::string &plannerName) {
+        planner->initialize(plannerName, tf, costmap_ros);
+    });
+
+    std::string initialMode;
+    nh.param<std::string>("initial_mode", initialMode, "default");
+
+    ros::NodeHandle private_nh("~");
+    PlannerModeSelector::getInstance().subscribe(private_nh, initialMode);
+}
+
+/**
+******************************************************************************************************************
+* getActivePlanner()
+******************************************************************************************************************
+*/
+nav_core::BaseLocalPlanner *MultiplexingLocalPlanner::getActivePlanner()
+{
+    bool changed;
+    auto planner = planners_.getActivePlanner(changed);
+
+    // the new planner continues with the plan received by the previous one
+    if (changed && planner != nullptr && !lastPlan_.empty())
+    {
+        planner->setPlan(lastPlan_);
+    }
+
+    return planner;
+}
+
+/**
+******************************************************************************************************************
+* computeVelocityCommands()
+******************************************************************************************************************
+*/
+bool MultiplexingLocalPlanner::computeVelocityCommands(geometry_msgs::Twist &cmd_vel)
+{
+    auto planner = this->getActivePlanner();
+    if (planner == nullptr)
+    {
+        ROS_ERROR("[MultiplexingLocalPlanner] no planner available for the current mode");
+        return false;
+    }
+
+    return planner->computeVelocityCommands(cmd_vel);
+}
+
+/**
+******************************************************************************************************************
+* isGoalReached()
+******************************************************************************************************************
+*/
+bool MultiplexingLocalPlanner::isGoalReached()
+{
+    auto planner = this->getActivePlanner();
+    if (planner == nullptr)
+        return false;
+
+    return planner->isGoalReached();
+}
+
+/**
+******************************************************************************************************************
+* setPlan()
+******************************************************************************************************************
+*/
+bool MultiplexingLocalPlanner::setPlan(const std::vector<geometry_msgs::PoseStamped> &plan)
+{
+    lastPlan_ = plan;
+
+    bool changed;
+    auto planner = planners_.getActivePlanner(changed);
+    if (planner == nullptr)
+    {
+        ROS_ERROR("[MultiplexingLocalPlanner] no planner available for the current mode");
+        return false;
+    }
+
+    return planner->setPlan(plan);
+}
+} // namespace multiplexing_planner
+} // namespace cl_move_base_z
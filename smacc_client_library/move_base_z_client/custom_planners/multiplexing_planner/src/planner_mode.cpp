@@ -0,0 +1,77 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <multiplexing_planner/planner_mode.h>
+
+namespace cl_move_base_z
+{
+namespace multiplexing_planner
+{
+PlannerModeSelector &PlannerModeSelector::getInstance()
+{
+    static PlannerModeSelector instance;
+    return instance;
+}
+
+PlannerModeSelector::PlannerModeSelector()
+    : version_(0)
+{
+}
+
+void PlannerModeSelector::setMode(const std::string &mode)
+{
+    ros::Publisher modeAckPub;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        modeAckPub = modeAckPub_;
+        if (mode != mode_)
+        {
+            mode_ = mode;
+            version_++;
+        }
+    }
+
+    // the planners read the new version in their next call, goals received from now on use this mode
+    if (modeAckPub)
+    {
+        std_msgs::String ackMsg;
+        ackMsg.data = mode;
+        modeAckPub.publish(ackMsg);
+    }
+}
+
+std::string PlannerModeSelector::getMode() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mode_;
+}
+
+void PlannerModeSelector::subscribe(ros::NodeHandle &nh, const std::string &initialMode)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!modeSub_)
+    {
+        if (mode_.empty())
+        {
+            mode_ = initialMode;
+            version_++;
+        }
+
+        modeAckPub_ = nh.advertise<std_msgs::String>("planner_mode_ack", 1, true /*latched*/);
+
+        std_msgs::String ackMsg;
+        ackMsg.data = mode_;
+        modeAckPub_.publish(ackMsg);
+
+        modeSub_ = nh.subscribe("planner_mode", 1, &PlannerModeSelector::onModeMsg, this);
+    }
+}
+
+void PlannerModeSelector::onModeMsg(const std_msgs::String::ConstPtr &msg)
+{
+    this->setMode(msg->data);
+}
+} // namespace multiplexing_planner
+} // namespace cl_move_base_z
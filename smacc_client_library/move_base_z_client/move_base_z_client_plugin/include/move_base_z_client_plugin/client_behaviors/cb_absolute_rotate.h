@@ -20,7 +20,6 @@ class CbAbsoluteRotate : public smacc::SmaccClientBehavior
 public:
     enum class SpiningPlanner {Default, PureSpinning, Forward};
 
-    tf::TransformListener listener;
 
     ClMoveBaseZ *moveBaseClient_;
 
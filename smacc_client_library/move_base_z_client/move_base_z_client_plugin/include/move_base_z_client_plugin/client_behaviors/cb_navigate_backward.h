@@ -21,7 +21,6 @@ public:
     // just a stub to show how to use parameterless constructor
     boost::optional<float> backwardSpeed;
 
-    tf::TransformListener listener;
 
     cl_move_base_z::ClMoveBaseZ *moveBaseClient_;
     cl_move_base_z::odom_tracker::OdomTracker *odomTracker_;
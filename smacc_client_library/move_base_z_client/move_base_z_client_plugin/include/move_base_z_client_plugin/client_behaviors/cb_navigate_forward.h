@@ -23,7 +23,6 @@ public:
     // just a stub to show how to use parameterless constructor
     boost::optional<float> forwardSpeed;
 
-    tf::TransformListener listener;
 
     ClMoveBaseZ *moveBaseClient_;
 
@@ -6,10 +6,11 @@
 #pragma once
 
 #include <move_base_z_client_plugin/move_base_z_client_plugin.h>
+#include <smacc/smacc_asynchronous_client_behavior.h>
 
 namespace cl_move_base_z
 {
-    class CbNavigateNextWaypoint : public smacc::SmaccClientBehavior
+    class CbNavigateNextWaypoint : public smacc::SmaccAsyncClientBehavior
     {
     public:
         CbNavigateNextWaypoint();
@@ -18,7 +18,6 @@ namespace cl_move_base_z
 class CbRotate : public smacc::SmaccClientBehavior
 {
 public:
-    tf::TransformListener listener;
 
     ClMoveBaseZ *moveBaseClient_;
 
@@ -17,7 +17,6 @@ namespace cl_move_base_z
 
 class CbUndoPathBackwards : public smacc::SmaccClientBehavior
 {
-  tf::TransformListener listener;
 
   ClMoveBaseZ *moveBaseClient_;
 
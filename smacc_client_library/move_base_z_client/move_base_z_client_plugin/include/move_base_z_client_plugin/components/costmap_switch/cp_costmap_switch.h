@@ -7,6 +7,9 @@
 
 #include <functional>
 #include <array>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <ros/ros.h>
 
 #include <move_base_z_client_plugin/move_base_z_client_plugin.h>
@@ -16,11 +19,21 @@
 #include <dynamic_reconfigure/Reconfigure.h>
 #include <dynamic_reconfigure/Config.h>
 
+#include <boost/optional.hpp>
 
 namespace cl_move_base_z
 {
 class CostmapProxy;
 
+// posted when all the layers of a setLayersAsync request have been applied (or failed)
+template <typename TSource, typename TObjectTag>
+struct EvCostmapLayersApplied : sc::event<EvCostmapLayersApplied<TSource, TObjectTag>>
+{
+    unsigned long requestId;
+    bool success;
+    std::vector<std::string> failedLayers;
+};
+
 class CostmapSwitch : public smacc::ISmaccComponent
 {
 public:
@@ -32,10 +45,16 @@ public:
         LOCAL_INFLATED_LAYER = 3
     };
 
+    // layer name -> enabled
+    typedef std::map<std::string, bool> LayerConfiguration;
+
     static std::array<std::string, 4> layerNames;
 
     CostmapSwitch();
 
+    // waits for the worker threads of the pending asynchronous requests
+    virtual ~CostmapSwitch();
+
     virtual void initialize(smacc::ISmaccClient *owner) override;
 
     static std::string getStandardCostmapName(StandardLayers layertype);
@@ -50,11 +69,57 @@ public:
 
     void disable(StandardLayers layerType);
 
+    // Applies the whole configuration without blocking the caller. The layers are grouped by costmap
+    // (the prefix of the layer name, ie: global_costmap) and every costmap is reconfigured by its own worker
+    // thread, so the global and local costmaps are switched in parallel. Layers already in the requested
+    // state (last state confirmed by their dynamic reconfigure server) are skipped. When every costmap is
+    // done an EvCostmapLayersApplied event is posted. Returns the request id carried by that event.
+    unsigned long setLayersAsync(const LayerConfiguration &configuration);
+
+    // blocking version of setLayersAsync, returns true if all the layers were applied
+    bool setLayers(const LayerConfiguration &configuration);
+
     void registerProxyFromDynamicReconfigureServer(std::string costmapName, std::string enablePropertyName = "enabled");
 
+    template <typename TObjectTag, typename TDerived>
+    void configureEventSourceTypes()
+    {
+        this->postLayersAppliedEvent = [=](unsigned long requestId, const std::vector<std::string> &failedLayers) {
+            auto event = new EvCostmapLayersApplied<TDerived, TObjectTag>();
+            event->requestId = requestId;
+            event->success = failedLayers.empty();
+            event->failedLayers = failedLayers;
+            this->postEvent(event);
+        };
+    }
+
 private:
+    struct PendingRequest
+    {
+        int pendingCostmaps;
+        std::vector<std::string> failedLayers;
+    };
+
+    typedef std::vector<std::pair<std::string, std::shared_ptr<CostmapProxy>>> LayerBatch;
+
+    // layers that are not in the requested state, grouped by costmap
+    std::map<std::string, LayerBatch> groupByCostmap(const LayerConfiguration &configuration, std::vector<std::string> &unknownLayers);
+
+    // applies the layers of a costmap, returns the layers that failed
+    static std::vector<std::string> applyBatch(const LayerBatch &batch);
+
+    void onCostmapBatchDone(unsigned long requestId, const std::vector<std::string> &failedLayers);
+
     std::map<std::string, std::shared_ptr<CostmapProxy>> costmapProxies;
     cl_move_base_z::ClMoveBaseZ *owner_;
+
+    std::function<void(unsigned long, const std::vector<std::string> &)> postLayersAppliedEvent;
+
+    std::mutex requestsMutex_;
+    std::condition_variable requestsDone_;
+    std::map<unsigned long, PendingRequest> pendingRequests_;
+    unsigned long nextRequestId_;
+    int activeWorkers_;
 };
 //-------------------------------------------------------------------------
 class CostmapProxy
@@ -62,13 +127,38 @@ class CostmapProxy
 public:
     CostmapProxy(std::string costmap_name, std::string enablePropertyName);
 
+    // blocking, nothing is sent if the layer is already in that state
     void setCostmapEnabled(bool value);
 
+    // Records the desired state. Returns false if the layer is already in that state (or a request for it
+    // is in flight) so nothing has to be sent.
+    bool requestEnabled(bool value);
+
+    // Sends the last requested state to the dynamic reconfigure server (blocking). Concurrent calls are
+    // serialized and always send the latest requested state, so the layer ends in the last requested
+    // state regardless of the order the worker threads run. Returns false if the server could not be called.
+    bool applyRequestedState();
+
+    boost::optional<bool> getConfirmedState();
+
 private:
     std::string costmapName_;
+    std::string enablePropertyName_;
     dynamic_reconfigure::Config enableReq;
     dynamic_reconfigure::Config disableReq;
 
+    // persistent connection to the dynamic reconfigure server, created on demand
+    ros::ServiceClient reconfigureClient_;
+
+    std::mutex stateMutex_;
+    std::mutex callMutex_;
+    boost::optional<bool> requestedState_;
+    boost::optional<bool> confirmedState_;
+    // requests accepted by requestEnabled that applyRequestedState has not finished yet
+    int pendingApplies_;
+
+    bool callReconfigure(bool value);
+
     void dynreconfCallback(const dynamic_reconfigure::Config::ConstPtr &configuration_update);
 
     ros::Subscriber dynrecofSub_;
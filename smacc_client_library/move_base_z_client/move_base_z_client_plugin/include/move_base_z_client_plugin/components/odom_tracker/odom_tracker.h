@@ -7,17 +7,24 @@
 
 #include <smacc/common.h>
 #include <smacc/component.h>
+#include <move_base_z_client_plugin/components/odom_tracker/path_store.h>
+#include <move_base_z_client_plugin/components/odom_tracker/path_simplifier.h>
+#include <move_base_z_client_plugin/OdomTrackerPathDelta.h>
+#include <forward_global_planner/shared_trail.h>
 
 #include <move_base_msgs/MoveBaseAction.h>
 
 #include <ros/ros.h>
 #include <vector>
+#include <algorithm>
 #include <nav_msgs/Odometry.h>
 #include <nav_msgs/Path.h>
 #include <tf/transform_datatypes.h>
 #include <realtime_tools/realtime_publisher.h>
+#include <condition_variable>
 #include <mutex>
 #include <memory>
+#include <thread>
 #include <geometry_msgs/Point.h>
 #include <std_msgs/Header.h>
 
@@ -41,6 +48,8 @@ public:
     // current path
     OdomTracker(std::string odomtopicName = "/odom", std::string odomFrame = "odom");
 
+    virtual ~OdomTracker();
+
     // threadsafe
     /// odom callback: Updates the path - this must be called periodically for each odometry message.
     // The odom parameters is the main input of this tracker
@@ -68,9 +77,13 @@ public:
     // threadsafe
     void setStartPoint(const geometry_msgs::Pose &pose);
 
-    // threadsafe
+    // threadsafe. Copy of the current path taken under the lock
     nav_msgs::Path getPath();
 
+    // threadsafe, lock free. Immutable snapshot of the current path. It is refreshed at publish_rate and
+    // immediately after pushPath, popPath, clearPath and setStartPoint
+    std::shared_ptr<const nav_msgs::Path> getPathSnapshot();
+
     void logStateString();
 
 protected:
@@ -82,12 +95,51 @@ protected:
     // this is called when a new odom message is received in clear path mode
     virtual bool updateClearPath(const nav_msgs::Odometry &odom);
 
-    void updateAggregatedStackPath();
+    // online simplification: replaces the last pose of the current path with the new one if all the poses
+    // dropped since the previous kept pose are within the simplification tolerances
+    bool trySimplifyLastPose(const geometry_msgs::PoseStamped &newPose);
+
+    // downsamples the stored paths if they exceed max_path_poses
+    void enforcePathSizeLimit();
+
+    // --- incremental path updates (odom_tracker_path_delta) ---
+    void notifyPoseAppended(const geometry_msgs::PoseStamped &pose);
+
+    void notifyPoseRemoved();
+
+    // the current path changed in a way that is not an append/remove at the end (push, pop, clear, set start point)
+    void notifyPathReset();
+
+    // the next delta message carries the whole current path
+    void resetPendingDelta();
+
+    void publishPathDelta(ros::Time timestamp);
+
+    // builds a new snapshot of the current path and swaps it atomically
+    void updatePathSnapshot();
+
+    // publishes the last path snapshot handed by rtPublishPaths. roscpp serializes the message in the publishing
+    // thread, this keeps it out of the odom callback and m_mutex_
+    void pathPublisherLoop();
 
     // -------------- OUTPUTS ---------------------
-    std::shared_ptr<realtime_tools::RealtimePublisher<nav_msgs::Path>> robotBasePathPub_;
+    // publishes the path snapshot itself, it is immutable so it is not copied
+    ros::Publisher robotBasePathPub_;
+
+    std::thread pathPublisherThread_;
+    std::mutex pathPublisherMutex_;
+    std::condition_variable pathPublisherCondition_;
+    // next snapshot to publish (null if already published)
+    std::shared_ptr<const nav_msgs::Path> pathToPublish_;
+    bool pathPublisherStop_;
     std::shared_ptr<realtime_tools::RealtimePublisher<nav_msgs::Path>> robotBasePathStackedPub_;
 
+    // not a realtime publisher: a dropped delta would corrupt the path copy of the subscribers
+    ros::Publisher robotBasePathDeltaPub_;
+
+    // current path in shared memory for the backward planners (optional)
+    std::unique_ptr<SharedTrailWriter> sharedTrail_;
+
     // --------------- INPUTS ------------------------
     // optional, this class can be used directly calling the odomProcessing method
     // without any subscriber
@@ -108,18 +160,46 @@ protected:
 
     std::string odomFrame_;
 
+    /// Meters. Maximum distance of a dropped pose to the simplified path. 0 disables the simplification
+    double simplificationTolerance_;
+
+    /// rads. Maximum orientation error of a dropped pose
+    double simplificationAngularTolerance_;
+
+    /// Meters. Maximum length of a simplified segment
+    double simplificationMaxSegmentLength_;
+
+    /// hard limit of stored poses (stacked paths + current path). 0 means unlimited
+    int maxPathPoses_;
+
+    /// Hz. Maximum rate of the full path messages. 0 publishes them with every odom message
+    double publishRate_;
+
     // --------------- STATE ---------------
     // default true
     bool publishMessages;
 
-    /// Processed path for the mouth of the reel
-    nav_msgs::Path baseTrajectory_;
+    /// stacked paths and current path (the processed path for the mouth of the reel)
+    PathStore pathStore_;
+
+    /// header of the current path, updated with each odom message
+    std_msgs::Header currentPathHeader_;
 
     WorkingMode workingMode_;
 
-    std::vector<nav_msgs::Path> pathStack_;
+    ros::Time lastPathPublication_;
+
+    // only accessed with std::atomic_load/std::atomic_store so that readers never take m_mutex_
+    std::shared_ptr<const nav_msgs::Path> pathSnapshot_;
+
+    bool snapshotDirty_;
+
+    PathSimplifier simplifier_;
+
+    // changes of the current path not yet published in the delta topic
+    OdomTrackerPathDelta pendingDelta_;
 
-    nav_msgs::Path aggregatedStackPathMsg_;
+    bool pendingDeltaChanges_;
 
     // subscribes to topic on init if true
     bool subscribeToOdometryTopic_;
@@ -0,0 +1,70 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <move_base_z_client_plugin/components/odom_tracker/path_store.h>
+#include <geometry_msgs/Point.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace cl_move_base_z
+{
+namespace odom_tracker
+{
+/// Online simplification of the current path of a PathStore. A new pose replaces the last pose of the path if
+/// all the poses dropped since the previous kept pose (the anchor) are within the tolerances of the segment
+/// anchor -> new pose. So every recorded pose stays within the tolerance of the simplified path.
+class PathSimplifier
+{
+public:
+    /// tolerance (meters) 0 disables the simplification, maxSegmentLength (meters) 0 or less: no length limit
+    PathSimplifier(double tolerance = 0, double angularTolerance = 0, double maxSegmentLength = 0);
+
+    inline bool isEnabled() const { return tolerance_ > 0; }
+
+    /// returns true if newPose replaced the last pose of the current path
+    bool simplifyLast(PathStore &path, const geometry_msgs::PoseStamped &newPose);
+
+    /// the current path changed in another way (push, pop, removed poses...), the next pose starts a new segment
+    void reset();
+
+private:
+    double tolerance_;
+
+    double angularTolerance_;
+
+    double maxSegmentLength_;
+
+    // poses removed since the last kept pose
+    std::vector<geometry_msgs::PoseStamped> droppedPoses_;
+};
+
+/**
+******************************************************************************************************************
+* p2segmentDistance()
+******************************************************************************************************************
+*/
+/// distance in the xy plane from p to the segment (a, b)
+inline double p2segmentDistance(const geometry_msgs::Point &p, const geometry_msgs::Point &a, const geometry_msgs::Point &b)
+{
+    double abx = b.x - a.x;
+    double aby = b.y - a.y;
+    double len2 = abx * abx + aby * aby;
+
+    double t = 0;
+    if (len2 > 0)
+    {
+        t = ((p.x - a.x) * abx + (p.y - a.y) * aby) / len2;
+        t = std::max(0.0, std::min(1.0, t));
+    }
+
+    double dx = p.x - (a.x + t * abx);
+    double dy = p.y - (a.y + t * aby);
+    return sqrt(dx * dx + dy * dy);
+}
+} // namespace odom_tracker
+} // namespace cl_move_base_z
@@ -0,0 +1,94 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <geometry_msgs/PoseStamped.h>
+#include <ros/time.h>
+#include <deque>
+#include <vector>
+
+namespace cl_move_base_z
+{
+namespace odom_tracker
+{
+/// Pose storage of the odom tracker. The poses of the stacked paths and the current path are kept
+/// contiguously in a chunked container (std::deque: no reallocation and O(1) push/pop at the end):
+///
+///    [ stacked path 0 | stacked path 1 | ... | current path ]
+///
+/// Pushing or popping a path only moves a segment boundary, so it is O(1) regardless of the path
+/// lengths. The aggregated stacked path is always the prefix before the current path, so it never
+/// needs to be rebuilt.
+class PathStore
+{
+public:
+    PathStore();
+
+    // ------ current path ------
+    void append(const geometry_msgs::PoseStamped &pose);
+
+    void removeLast();
+
+    void replaceLast(const geometry_msgs::PoseStamped &pose);
+
+    inline bool currentEmpty() const { return poses_.size() == currentStart_; }
+
+    inline size_t currentSize() const { return poses_.size() - currentStart_; }
+
+    inline const geometry_msgs::PoseStamped &currentFront() const { return poses_[currentStart_]; }
+
+    inline const geometry_msgs::PoseStamped &currentBack() const { return poses_.back(); }
+
+    inline const geometry_msgs::PoseStamped &currentAt(size_t index) const { return poses_[currentStart_ + index]; }
+
+    // replaces the first pose of the current path (or adds it if the current path is empty)
+    void setCurrentStart(const geometry_msgs::PoseStamped &pose);
+
+    void clearCurrent();
+
+    // ------ path stack ------
+    /// the current path is stacked and a new empty current path is started
+    void pushPath(const ros::Time &stamp);
+
+    /// the last stacked path is prepended to the current path. Returns false if the stack is empty
+    bool popPath();
+
+    inline size_t stackSize() const { return segments_.size(); }
+
+    size_t stackedPathSize(size_t index) const;
+
+    ros::Time stackedPathStamp(size_t index) const;
+
+    /// amount of poses of all the stacked paths
+    inline size_t stackedPosesCount() const { return currentStart_; }
+
+    /// amount of poses of the stacked paths and the current path
+    inline size_t size() const { return poses_.size(); }
+
+    /// removes every other pose of each path, keeping the first and the last pose of each one
+    void downsample();
+
+    // ------ message views ------
+    void copyCurrentPath(std::vector<geometry_msgs::PoseStamped> &poses) const;
+
+    void copyStackedPath(std::vector<geometry_msgs::PoseStamped> &poses) const;
+
+private:
+    struct StackedPath
+    {
+        size_t start;
+        ros::Time stamp;
+    };
+
+    std::deque<geometry_msgs::PoseStamped> poses_;
+
+    std::vector<StackedPath> segments_;
+
+    // index of the first pose of the current path
+    size_t currentStart_;
+};
+} // namespace odom_tracker
+} // namespace cl_move_base_z
@@ -11,6 +11,8 @@
 #include <dynamic_reconfigure/Config.h>
 #include <dynamic_reconfigure/DoubleParameter.h>
 #include <dynamic_reconfigure/Reconfigure.h>
+#include <std_msgs/String.h>
+#include <ros/callback_queue.h>
 #include <ros/ros.h>
 #include <functional>
 
@@ -29,13 +31,30 @@ public:
   // sets ROS defaults local and global planners
   void setDefaultPlanners();
 
+  // true if move_base is configured with the multiplexing_planner plugins. In that case switching planners
+  // is immediate and there is no need to wait for move_base to reload its plugins: the set*Planner methods
+  // only return when move_base acknowledged the new mode, so the next goal is planned with it
+  bool usesMultiplexingPlanner() const;
+
+  // mode of the last planners requested: default, forward, backward or pure_spinning (empty if none)
+  const std::string& getMode() const;
+
 private:
   std::string desired_global_planner_;
   std::string desired_local_planner_;
+  std::string desired_mode_;
+  bool multiplexing_;
+  ros::Publisher plannerModePub_;
+
+  // the mode acks are received in a private queue, so they can be waited for from any thread
+  ros::CallbackQueue modeAckQueue_;
+  ros::Subscriber modeAckSub_;
+  std::string acknowledgedMode_;
   ros::Subscriber dynrecofSub_;
   bool set_planners_mode_flag;
 
   void updatePlanners(bool subscribecallback = true);
   void dynreconfCallback(const dynamic_reconfigure::Config::ConstPtr& configuration_update);
+  void modeAckCallback(const std_msgs::String::ConstPtr& msg);
 };
 }  // namespace cl_move_base_z
@@ -6,21 +6,28 @@
 #pragma once
 
 #include <smacc/component.h>
-#include <smacc/smacc_updatable.h>
+#include <smacc/client_base_components/cp_tf_listener.h>
 
-#include <geometry_msgs/Pose.h>
-#include <tf/transform_listener.h>
+#include <geometry_msgs/PoseStamped.h>
 #include <tf/transform_datatypes.h>
+#include <atomic>
 #include <mutex>
 
 namespace cl_move_base_z
 {
-class Pose : public smacc::ISmaccComponent, public smacc::ISmaccUpdatable
+// Tracks the pose of a frame in a reference frame. The pose is updated when tf receives a newer transform
+// (through the process wide CpTfListener), it is not polled.
+class Pose : public smacc::ISmaccComponent
 {
 public:
     Pose(std::string poseFrameName = "base_link", std::string referenceFrame = "odom");
 
-    virtual void update() override;
+    virtual ~Pose();
+
+    virtual void initialize(smacc::ISmaccClient *owner) override;
+
+    // forces a lookup of the latest available transform
+    void update();
 
     void waitTransformUpdate(ros::Rate r = ros::Rate(20));
     
@@ -41,11 +48,15 @@ public:
         return referenceFrame_;
     }
 
-    bool isInitialized;
+    // written from the tf listener thread
+    std::atomic<bool> isInitialized;
 
 private:
+    void onTransformUpdate(const geometry_msgs::TransformStamped &transform);
+
     geometry_msgs::PoseStamped pose_;
-    tf::TransformListener tfListener_;
+    smacc::components::CpTfListener *tfListener_;
+    unsigned long transformSubscription_;
     std::string poseFrameName_;
     std::string referenceFrame_;
 
@@ -0,0 +1,110 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#pragma once
+
+#include <forward_global_planner/cell_grid.h>
+#include <geometry_msgs/Pose.h>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cl_move_base_z
+{
+/// Waypoint storage of the WaypointNavigator for large routes (tens of thousands of waypoints).
+///
+/// The sequence is an implicit treap (nodes ordered by position, balanced by random priorities), so
+/// access, insertion and removal at any index are O(log n). Nodes live in a pool and keep a stable id while
+/// they are in the route, which is what the spatial index stores: a uniform grid over the waypoint
+/// positions used to find the nearest unvisited waypoint.
+class WaypointRoute
+{
+public:
+    WaypointRoute(double cellSize = 1.0);
+
+    inline size_t size() const { return root_ < 0 ? 0 : nodes_[root_].size; }
+
+    inline bool empty() const { return root_ < 0; }
+
+    const geometry_msgs::Pose &at(size_t index) const;
+
+    void insert(size_t index, const geometry_msgs::Pose &pose);
+
+    void erase(size_t index);
+
+    void clear();
+
+    void assign(const std::vector<geometry_msgs::Pose> &poses);
+
+    /// builds the route in O(n) from a pose source (ie: a memory mapped file) without intermediate copies
+    void build(size_t count, std::function<void(size_t, geometry_msgs::Pose &)> getPose);
+
+    std::vector<geometry_msgs::Pose> toVector() const;
+
+    void setVisited(size_t index, bool visited);
+
+    bool isVisited(size_t index) const;
+
+    void clearVisited();
+
+    /// index of the unvisited waypoint closest to (x, y) or -1 if all the waypoints were visited
+    long nearestUnvisited(double x, double y) const;
+
+private:
+    struct Node
+    {
+        geometry_msgs::Pose pose;
+        uint32_t priority;
+        int left;
+        int right;
+        int parent;
+        int size;
+        bool visited;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<int> freeNodes_;
+    int root_;
+
+    std::mt19937 random_;
+
+    inline int nodeSize(int t) const { return t < 0 ? 0 : nodes_[t].size; }
+
+    int allocate(const geometry_msgs::Pose &pose);
+
+    int findNode(size_t index) const;
+
+    size_t rank(int node) const;
+
+    void update(int t);
+
+    void split(int t, size_t k, int &l, int &r);
+
+    int merge(int l, int r);
+
+    int buildBalanced(int lo, int hi);
+
+    // ------ spatial index ------
+    double cellSize_;
+    std::unordered_map<int64_t, std::vector<int>> cells_;
+    CellBounds cellBounds_;
+
+    void cellOf(const geometry_msgs::Pose &pose, int &cx, int &cy) const;
+
+    void indexNode(int node);
+
+    void unindexNode(int node);
+};
+
+/// Binary route file: a header followed by count records of 7 little endian doubles
+/// (position x y z, orientation x y z w). Loading maps the file in memory and builds the route from it.
+bool saveWaypointsBinary(const std::string &filepath, const WaypointRoute &route);
+
+/// returns false if the file is not a binary route file
+bool loadWaypointsBinary(const std::string &filepath, WaypointRoute &route);
+} // namespace cl_move_base_z
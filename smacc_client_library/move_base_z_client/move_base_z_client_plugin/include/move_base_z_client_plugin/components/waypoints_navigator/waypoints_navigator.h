@@ -9,6 +9,7 @@
 #include <smacc/smacc.h>
 #include <geometry_msgs/Pose.h>
 #include <move_base_z_client_plugin/components/waypoints_navigator/waypoints_event_dispatcher.h>
+#include <move_base_z_client_plugin/components/waypoints_navigator/waypoint_route.h>
 #include <move_base_z_client_plugin/move_base_z_client_plugin.h>
 
 namespace cl_move_base_z
@@ -47,18 +48,46 @@ public:
 
   void removeWaypoint(int index);
 
+  // loads a yaml waypoints file or a binary route file (see saveWayPointsToBinaryFile)
   void loadWayPointsFromFile(std::string filepath);
 
+  // binary route format, memory mapped on load. Recommended for large routes
+  bool saveWayPointsToBinaryFile(std::string filepath) const;
+
   void setWaypoints(const std::vector<geometry_msgs::Pose> &waypoints);
 
   void setWaypoints(const std::vector<Pose2D> &waypoints);
 
+  // sets the waypoint planners, waits for move_base to reload them (if needed) and sends the current waypoint
+  // goal (blocking)
   void sendNextGoal();
 
-  const std::vector<geometry_msgs::Pose> &getWaypoints() const;
+  // Look-ahead mode (waypoints > 0): the waypoints are navigated with the forward planners and, when a goal is
+  // sent, the following waypoints are published to the ForwardGlobalPlanner so that it plans them in background
+  // while the robot drives. 0 (default) navigates the waypoints with the default planners.
+  void setLookAhead(int waypoints);
+
+  int getLookAhead() const;
+
+  // planners used to navigate the waypoints: the default planners or the forward planners in look-ahead mode
+  void setWaypointPlanners();
+
+  // false if the waypoint planners are already set, so there is no need to wait for move_base to reload them
+  bool requiresPlannerSwitch() const;
+
+  // sends the current waypoint goal, the default planners are assumed to be already configured
+  void sendNextGoalWithCurrentPlanners();
+
+  std::vector<geometry_msgs::Pose> getWaypoints() const;
+
+  const WaypointRoute &getRoute() const;
 
   long getCurrentWaypointIndex() const;
 
+  // Sets the current waypoint to the closest waypoint not reached yet (ie: after a recovery that moved
+  // the robot away from the route). Returns false if there is no pose available or every waypoint was reached
+  bool resumeFromNearestUnvisitedWaypoint();
+
   template <typename TObjectTag, typename TDerived>
   void configureEventSourceTypes()
   {
@@ -70,7 +99,13 @@ public:
 private:
   void onGoalReached(ClMoveBaseZ::ResultConstPtr &res);
 
-  std::vector<geometry_msgs::Pose> waypoints_;
+  void publishLookAheadGoals(const std::string &frameId);
+
+  int lookAhead_;
+
+  ros::Publisher lookAheadGoalsPub_;
+
+  WaypointRoute waypoints_;
 
   boost::signals2::connection succeddedConnection_;
 };
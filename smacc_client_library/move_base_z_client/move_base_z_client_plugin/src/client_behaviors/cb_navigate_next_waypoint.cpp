@@ -1,5 +1,6 @@
 #include <move_base_z_client_plugin/client_behaviors/cb_navigate_next_waypoint.h>
 #include <move_base_z_client_plugin/components/waypoints_navigator/waypoints_navigator.h>
+#include <move_base_z_client_plugin/components/planner_switcher/planner_switcher.h>
 
 namespace cl_move_base_z
 {
@@ -18,8 +19,26 @@ namespace cl_move_base_z
         this->requiresClient(move_base);
 
         auto waypointsNavigator = move_base->getComponent<WaypointNavigator>();
-        waypointsNavigator->sendNextGoal();
-        ROS_INFO("[CbNavigateNextWaypoint] current iteration waypoints x: %ld", waypointsNavigator->getCurrentWaypointIndex());
+        auto plannerSwitcher = move_base->getComponent<PlannerSwitcher>();
+
+        if (plannerSwitcher->usesMultiplexingPlanner() || !waypointsNavigator->requiresPlannerSwitch())
+        {
+            // the planner switch is immediate (or not needed), the goal can be sent right away
+            waypointsNavigator->setWaypointPlanners();
+            waypointsNavigator->sendNextGoalWithCurrentPlanners();
+            ROS_INFO("[CbNavigateNextWaypoint] current iteration waypoints x: %ld", waypointsNavigator->getCurrentWaypointIndex());
+            return;
+        }
+
+        // the planner switch is a blocking dynamic reconfigure call, it is done in a worker thread
+        this->runAsync([=]() { waypointsNavigator->setWaypointPlanners(); },
+                       [=]() {
+                           // give move_base some time to reload the planners without blocking the state machine
+                           this->delay(ros::Duration(5), [=]() {
+                               waypointsNavigator->sendNextGoalWithCurrentPlanners();
+                               ROS_INFO("[CbNavigateNextWaypoint] current iteration waypoints x: %ld", waypointsNavigator->getCurrentWaypointIndex());
+                           });
+                       });
     }
 
     void CbNavigateNextWaypoint::onExit()
@@ -11,7 +11,8 @@ void CbUndoPathBackwards::onEntry()
 
     auto plannerSwitcher = moveBaseClient_->getComponent<PlannerSwitcher>();
 
-    nav_msgs::Path forwardpath = odomTracker->getPath();
+    // lock free, it does not stall the odometry processing
+    auto forwardpath = odomTracker->getPathSnapshot();
     //ROS_INFO_STREAM("[UndoPathBackward] Current path backwards: " << forwardpath);
 
     odomTracker->setWorkingMode(WorkingMode::CLEAR_PATH);
@@ -19,9 +20,9 @@ void CbUndoPathBackwards::onEntry()
     ClMoveBaseZ::Goal goal;
     // this line is used to flush/reset backward planner in the case it were already there
     //plannerSwitcher->setDefaultPlanners();
-    if (forwardpath.poses.size() > 0)
+    if (forwardpath->poses.size() > 0)
     {
-        goal.target_pose = forwardpath.poses.front();
+        goal.target_pose = forwardpath->poses.front();
         plannerSwitcher->setBackwardPlanner();
         moveBaseClient_->sendGoal(goal);
     }
@@ -1,4 +1,5 @@
 #include <move_base_z_client_plugin/components/costmap_switch/cp_costmap_switch.h>
+#include <thread>
 
 namespace cl_move_base_z
 {
@@ -7,7 +8,7 @@ std::array<std::string, 4>
     CostmapSwitch::layerNames =
         {
             "global_costmap/obstacles_layer",
-            "local_costmap/obstacles_layer"
+            "local_costmap/obstacles_layer",
             "global_costmap/inflater_layer",
             "local_costmap/inflater_layer"};
 
@@ -19,9 +20,16 @@ void CostmapSwitch::registerProxyFromDynamicReconfigureServer(std::string costma
 }
 
 CostmapSwitch::CostmapSwitch()
+    : nextRequestId_(1), activeWorkers_(0)
 {
 }
 
+CostmapSwitch::~CostmapSwitch()
+{
+    std::unique_lock<std::mutex> lock(requestsMutex_);
+    requestsDone_.wait(lock, [this] { return activeWorkers_ == 0; });
+}
+
 void CostmapSwitch::initialize(smacc::ISmaccClient *owner)
 {
     this->owner_ = dynamic_cast<cl_move_base_z::ClMoveBaseZ *>(owner);
@@ -94,45 +102,267 @@ void CostmapSwitch::disable(StandardLayers layerType)
     this->disable(getStandardCostmapName(layerType));
 }
 
+std::map<std::string, CostmapSwitch::LayerBatch> CostmapSwitch::groupByCostmap(const LayerConfiguration &configuration,
+                                                                               std::vector<std::string> &unknownLayers)
+{
+    std::map<std::string, LayerBatch> batches;
+    for (auto &entry : configuration)
+    {
+        auto &layerName = entry.first;
+        if (!exists(layerName))
+        {
+            ROS_ERROR("[CostmapSwitch] costmap %s does not exist", layerName.c_str());
+            unknownLayers.push_back(layerName);
+            continue;
+        }
+
+        auto &proxy = costmapProxies[layerName];
+        if (!proxy->requestEnabled(entry.second))
+        {
+            ROS_DEBUG("[CostmapSwitch] %s is already %s. Skipping.", layerName.c_str(), entry.second ? "enabled" : "disabled");
+            continue;
+        }
+
+        auto costmapName = layerName.substr(0, layerName.find('/'));
+        batches[costmapName].push_back(std::make_pair(layerName, proxy));
+    }
+
+    return batches;
+}
+
+std::vector<std::string> CostmapSwitch::applyBatch(const LayerBatch &batch)
+{
+    std::vector<std::string> failedLayers;
+    for (auto &layer : batch)
+    {
+        if (!layer.second->applyRequestedState())
+            failedLayers.push_back(layer.first);
+    }
+
+    return failedLayers;
+}
+
+unsigned long CostmapSwitch::setLayersAsync(const LayerConfiguration &configuration)
+{
+    std::vector<std::string> unknownLayers;
+    auto batches = groupByCostmap(configuration, unknownLayers);
+
+    unsigned long requestId;
+    {
+        std::lock_guard<std::mutex> lock(requestsMutex_);
+        requestId = nextRequestId_++;
+
+        if (!batches.empty())
+        {
+            auto &request = pendingRequests_[requestId];
+            request.pendingCostmaps = batches.size();
+            request.failedLayers = unknownLayers;
+            activeWorkers_ += batches.size();
+        }
+    }
+
+    if (batches.empty())
+    {
+        // nothing to send, the configuration is already applied
+        if (postLayersAppliedEvent)
+            postLayersAppliedEvent(requestId, unknownLayers);
+
+        return requestId;
+    }
+
+    for (auto &entry : batches)
+    {
+        ROS_INFO("[CostmapSwitch] request %lu: reconfiguring %lu layers of %s", requestId, entry.second.size(), entry.first.c_str());
+
+        auto batch = entry.second;
+        std::thread([this, requestId, batch]() {
+            auto failedLayers = applyBatch(batch);
+            this->onCostmapBatchDone(requestId, failedLayers);
+        })
+            .detach();
+    }
+
+    return requestId;
+}
+
+void CostmapSwitch::onCostmapBatchDone(unsigned long requestId, const std::vector<std::string> &failedLayers)
+{
+    std::vector<std::string> requestFailedLayers;
+    bool requestDone = false;
+    {
+        std::lock_guard<std::mutex> lock(requestsMutex_);
+        auto &request = pendingRequests_[requestId];
+        request.failedLayers.insert(request.failedLayers.end(), failedLayers.begin(), failedLayers.end());
+
+        if (--request.pendingCostmaps == 0)
+        {
+            requestDone = true;
+            requestFailedLayers = request.failedLayers;
+            pendingRequests_.erase(requestId);
+        }
+    }
+
+    if (requestDone)
+    {
+        ROS_INFO("[CostmapSwitch] request %lu done. Failed layers: %lu", requestId, requestFailedLayers.size());
+        if (postLayersAppliedEvent)
+            postLayersAppliedEvent(requestId, requestFailedLayers);
+    }
+
+    // the last notification of the worker, from here the component may be destroyed
+    std::lock_guard<std::mutex> lock(requestsMutex_);
+    activeWorkers_--;
+    requestsDone_.notify_all();
+}
+
+bool CostmapSwitch::setLayers(const LayerConfiguration &configuration)
+{
+    std::vector<std::string> unknownLayers;
+    auto batches = groupByCostmap(configuration, unknownLayers);
+
+    // the costmaps are reconfigured in parallel, the last one in this thread
+    std::vector<std::thread> workers;
+    std::vector<std::vector<std::string>> failedLayers(batches.size());
+    int i = 0;
+    for (auto &entry : batches)
+    {
+        auto &batch = entry.second;
+        auto &failed = failedLayers[i++];
+        if (i < (int)batches.size())
+            workers.push_back(std::thread([&batch, &failed]() { failed = applyBatch(batch); }));
+        else
+            failed = applyBatch(batch);
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    bool success = unknownLayers.empty();
+    for (auto &failed : failedLayers)
+        success = success && failed.empty();
+
+    return success;
+}
+
 //-------------------------------------------------------------------------
 
 CostmapProxy::CostmapProxy(std::string costmap_name, std::string enablePropertyName)
+    : enablePropertyName_(enablePropertyName), pendingApplies_(0)
 {
     this->costmapName_ = costmap_name + "/set_parameters";
     dynamic_reconfigure::BoolParameter enableField;
-    enableField.name = "enabled";
+    enableField.name = enablePropertyName;
     enableField.value = true;
 
     enableReq.bools.push_back(enableField);
 
     enableField.value = false;
     disableReq.bools.push_back(enableField);
+
+    // keeps the confirmed state up to date also when the layer is reconfigured by other nodes
+    ros::NodeHandle nh;
+    dynrecofSub_ = nh.subscribe(costmap_name + "/parameter_updates", 1, &CostmapProxy::dynreconfCallback, this);
 }
 
 void CostmapProxy::setCostmapEnabled(bool value)
 {
-    dynamic_reconfigure::ReconfigureRequest srv_req;
-    dynamic_reconfigure::ReconfigureResponse srv_resp;
+    if (this->requestEnabled(value))
+    {
+        this->applyRequestedState();
+    }
+}
+
+bool CostmapProxy::requestEnabled(bool value)
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    if (requestedState_ && *requestedState_ == value && (pendingApplies_ > 0 || confirmedState_ == value))
+    {
+        return false;
+    }
+    else if (!requestedState_ && confirmedState_ == value)
+    {
+        return false;
+    }
+
+    requestedState_ = value;
+    pendingApplies_++;
+    return true;
+}
+
+bool CostmapProxy::applyRequestedState()
+{
+    std::lock_guard<std::mutex> callLock(callMutex_);
+
+    bool value;
+    bool pending;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        value = *requestedState_;
+        pending = confirmedState_ != value;
+    }
+
+    // a previous call already sent the latest requested state
+    bool success = true;
+    if (pending)
+    {
+        success = this->callReconfigure(value);
+    }
+
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    pendingApplies_--;
+    return success;
+}
+
+boost::optional<bool> CostmapProxy::getConfirmedState()
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return confirmedState_;
+}
+
+bool CostmapProxy::callReconfigure(bool value)
+{
+    dynamic_reconfigure::Reconfigure srv;
 
     if (value)
-        srv_req.config = enableReq;
+        srv.request.config = enableReq;
     else
-        srv_req.config = disableReq;
+        srv.request.config = disableReq;
 
-    if (ros::service::exists(costmapName_, true))
+    if (!reconfigureClient_.isValid())
     {
-        ROS_INFO("sending dynamic reconfigure request: %s", costmapName_.c_str());
-        ros::service::call(costmapName_, srv_req, srv_resp);
+        ros::NodeHandle nh;
+        reconfigureClient_ = nh.serviceClient<dynamic_reconfigure::Reconfigure>(costmapName_, true);
     }
-    else
+
+    ROS_INFO("sending dynamic reconfigure request: %s", costmapName_.c_str());
+    if (!reconfigureClient_.call(srv))
+    {
+        ROS_WARN("could not call dynamic reconfigure server: %s", costmapName_.c_str());
+
+        // the persistent connection is recreated in the next call
+        reconfigureClient_.shutdown();
+        return false;
+    }
+
     {
-        ROS_WARN("could not call dynamic reconfigure server. It does not exist: %s", costmapName_.c_str());
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        confirmedState_ = value;
     }
+
+    // the response carries the configuration actually applied by the server
+    this->dynreconfCallback(boost::make_shared<dynamic_reconfigure::Config>(srv.response.config));
+    return true;
 }
 
 void CostmapProxy::dynreconfCallback(const dynamic_reconfigure::Config::ConstPtr &configuration_update)
 {
-    // auto gp = std::find_if(configuration_update->strs.begin(), configuration_update->strs.begin(),
-    //                        [&](const dynamic_reconfigure::StrParameter &p) { return p.name == "base_global_planner" && p.value == desired_global_planner_; });
+    for (auto &p : configuration_update->bools)
+    {
+        if (p.name == enablePropertyName_)
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            confirmedState_ = (bool)p.value;
+        }
+    }
+}
 }
-}
\ No newline at end of file
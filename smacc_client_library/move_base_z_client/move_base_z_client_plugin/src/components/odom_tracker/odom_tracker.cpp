@@ -52,13 +52,92 @@ OdomTracker::OdomTracker(std::string odomTopicName, std::string odomFrame)
     }
     ROS_INFO_STREAM("[OdomTracker] clear_angular_distance_threshold :" << clearAngularDistanceThreshold_);
 
+    if (!nh.getParam("simplification_tolerance", simplificationTolerance_))
+    {
+        simplificationTolerance_ = 0; // disabled
+    }
+    ROS_INFO_STREAM("[OdomTracker] simplification_tolerance :" << simplificationTolerance_);
+
+    if (!nh.getParam("simplification_angular_tolerance", simplificationAngularTolerance_))
+    {
+        simplificationAngularTolerance_ = 0.05; // radians
+    }
+    ROS_INFO_STREAM("[OdomTracker] simplification_angular_tolerance :" << simplificationAngularTolerance_);
+
+    if (!nh.getParam("simplification_max_segment_length", simplificationMaxSegmentLength_))
+    {
+        simplificationMaxSegmentLength_ = 0.5; // meters
+    }
+    ROS_INFO_STREAM("[OdomTracker] simplification_max_segment_length :" << simplificationMaxSegmentLength_);
+    simplifier_ = PathSimplifier(simplificationTolerance_, simplificationAngularTolerance_, simplificationMaxSegmentLength_);
+
+    if (!nh.getParam("max_path_poses", maxPathPoses_))
+    {
+        maxPathPoses_ = 0; // unlimited
+    }
+    ROS_INFO_STREAM("[OdomTracker] max_path_poses :" << maxPathPoses_);
+
+    if (!nh.getParam("publish_rate", publishRate_))
+    {
+        publishRate_ = 0; // with every odom message
+    }
+    ROS_INFO_STREAM("[OdomTracker] publish_rate :" << publishRate_);
+
+    robotBasePathPub_ = nh.advertise<nav_msgs::Path>("odom_tracker_path", 1);
+    pathPublisherStop_ = false;
+    pathPublisherThread_ = std::thread(&OdomTracker::pathPublisherLoop, this);
+    robotBasePathStackedPub_ = std::make_shared<realtime_tools::RealtimePublisher<nav_msgs::Path>>(nh, "odom_tracker_stacked_path", 1);
+    robotBasePathDeltaPub_ = nh.advertise<OdomTrackerPathDelta>("odom_tracker_path_delta", 100);
+
+    bool useSharedTrail;
+    if (!nh.getParam("shared_trail", useSharedTrail))
+    {
+        useSharedTrail = true;
+    }
+    ROS_INFO_STREAM("[OdomTracker] shared_trail :" << useSharedTrail);
+
+    if (useSharedTrail)
+    {
+        std::string sharedTrailName;
+        if (!nh.getParam("shared_trail_name", sharedTrailName))
+        {
+            sharedTrailName = getDefaultSharedTrailName();
+        }
+
+        try
+        {
+            sharedTrail_.reset(new SharedTrailWriter(sharedTrailName, maxPathPoses_ > 0 ? maxPathPoses_ : 20000));
+        }
+        catch (const boost::interprocess::interprocess_exception &ex)
+        {
+            ROS_ERROR_STREAM("[OdomTracker] shared memory trail '" << sharedTrailName << "' could not be created: " << ex.what());
+        }
+    }
+
+    // the first delta message is always a reset
+    pendingDelta_.sequence = 0;
+    notifyPathReset();
+    updatePathSnapshot();
+
+    // subscribed when the state is fully initialized
     if (this->subscribeToOdometryTopic_)
     {
         odomSub_ = nh.subscribe(odomTopicName, 1, &OdomTracker::processOdometryMessage, this);
     }
+}
 
-    robotBasePathPub_ = std::make_shared<realtime_tools::RealtimePublisher<nav_msgs::Path>>(nh, "odom_tracker_path", 1);
-    robotBasePathStackedPub_ = std::make_shared<realtime_tools::RealtimePublisher<nav_msgs::Path>>(nh, "odom_tracker_stacked_path", 1);
+OdomTracker::~OdomTracker()
+{
+    odomSub_.shutdown();
+
+    {
+        std::lock_guard<std::mutex> lock(pathPublisherMutex_);
+        pathPublisherStop_ = true;
+    }
+    pathPublisherCondition_.notify_all();
+
+    if (pathPublisherThread_.joinable())
+        pathPublisherThread_.join();
 }
 
 /**
@@ -86,7 +165,6 @@ void OdomTracker::setPublishMessages(bool value)
     std::lock_guard<std::mutex> lock(m_mutex_);
     publishMessages = value;
     //ROS_INFO("odom_tracker m_mutex release");
-    this->updateAggregatedStackPath();
 }
 
 void OdomTracker::pushPath()
@@ -96,13 +174,13 @@ void OdomTracker::pushPath()
     ROS_INFO("PUSH_PATH PATH EXITING");
     this->logStateString();
 
-    pathStack_.push_back(baseTrajectory_);
-    baseTrajectory_.poses.clear();
+    pathStore_.pushPath(ros::Time::now());
+    this->notifyPathReset();
+    this->updatePathSnapshot();
 
     ROS_INFO("PUSH_PATH PATH EXITING");
     this->logStateString();
     ROS_INFO("odom_tracker m_mutex release");
-    this->updateAggregatedStackPath();
 }
 
 void OdomTracker::popPath(int items, bool keepPreviousPath)
@@ -115,36 +193,33 @@ void OdomTracker::popPath(int items, bool keepPreviousPath)
 
     if (!keepPreviousPath)
     {
-        baseTrajectory_.poses.clear();
+        pathStore_.clearCurrent();
     }
 
-    while (items > 0 && !pathStack_.empty())
+    // the stacked paths are stored just before the current path, so each pop only moves the boundary
+    while (items > 0 && pathStore_.popPath())
     {
-        auto &stacked = pathStack_.back().poses;
-        baseTrajectory_.poses.insert(baseTrajectory_.poses.begin(), stacked.begin(), stacked.end());
-        pathStack_.pop_back();
         items--;
 
         ROS_INFO("POP PATH Iteration ");
         this->logStateString();
     }
+    this->notifyPathReset();
+    this->updatePathSnapshot();
 
     ROS_INFO("POP PATH EXITING");
     this->logStateString();
     ROS_INFO("odom_tracker m_mutex release");
-    this->updateAggregatedStackPath();
 }
 
 void OdomTracker::logStateString()
 {
     ROS_INFO("--- odom tracker state ---");
-    ROS_INFO(" - path stack size: %ld", pathStack_.size());
-    ROS_INFO(" - active path size: %ld", baseTrajectory_.poses.size());
-    int i = 0;
-    for (auto &p : pathStack_)
+    ROS_INFO(" - path stack size: %ld", pathStore_.stackSize());
+    ROS_INFO(" - active path size: %ld", pathStore_.currentSize());
+    for (size_t i = 0; i < pathStore_.stackSize(); i++)
     {
-        ROS_INFO_STREAM(" - p " << i << "[" << p.header.stamp << "], size: " << p.poses.size());
-        i++;
+        ROS_INFO_STREAM(" - p " << i << "[" << pathStore_.stackedPathStamp(i) << "], size: " << pathStore_.stackedPathSize(i));
     }
     ROS_INFO("---");
 }
@@ -152,26 +227,22 @@ void OdomTracker::logStateString()
 void OdomTracker::clearPath()
 {
     std::lock_guard<std::mutex> lock(m_mutex_);
-    baseTrajectory_.poses.clear();
+    pathStore_.clearCurrent();
+    this->notifyPathReset();
+    this->updatePathSnapshot();
 
     rtPublishPaths(ros::Time::now());
+    publishPathDelta(ros::Time::now());
     this->logStateString();
-    this->updateAggregatedStackPath();
 }
 
 void OdomTracker::setStartPoint(const geometry_msgs::PoseStamped &pose)
 {
     std::lock_guard<std::mutex> lock(m_mutex_);
     ROS_INFO_STREAM("[OdomTracker] set current path starting point: " << pose);
-    if (baseTrajectory_.poses.size() > 0)
-    {
-        baseTrajectory_.poses[0] = pose;
-    }
-    else
-    {
-        baseTrajectory_.poses.push_back(pose);
-    }
-    this->updateAggregatedStackPath();
+    pathStore_.setCurrentStart(pose);
+    this->notifyPathReset();
+    this->updatePathSnapshot();
 }
 
 void OdomTracker::setStartPoint(const geometry_msgs::Pose &pose)
@@ -183,21 +254,46 @@ void OdomTracker::setStartPoint(const geometry_msgs::Pose &pose)
     posestamped.header.stamp = ros::Time::now();
     posestamped.pose = pose;
 
-    if (baseTrajectory_.poses.size() > 0)
-    {
-        baseTrajectory_.poses[0] = posestamped;
-    }
-    else
-    {
-        baseTrajectory_.poses.push_back(posestamped);
-    }
-    this->updateAggregatedStackPath();
+    pathStore_.setCurrentStart(posestamped);
+    this->notifyPathReset();
+    this->updatePathSnapshot();
 }
 
 nav_msgs::Path OdomTracker::getPath()
 {
     std::lock_guard<std::mutex> lock(m_mutex_);
-    return this->baseTrajectory_;
+    nav_msgs::Path path;
+    path.header = currentPathHeader_;
+    if (path.header.frame_id.empty())
+    {
+        path.header.frame_id = this->odomFrame_;
+    }
+    pathStore_.copyCurrentPath(path.poses);
+    return path;
+}
+
+std::shared_ptr<const nav_msgs::Path> OdomTracker::getPathSnapshot()
+{
+    return std::atomic_load(&pathSnapshot_);
+}
+
+/**
+******************************************************************************************************************
+* updatePathSnapshot()
+******************************************************************************************************************
+*/
+void OdomTracker::updatePathSnapshot()
+{
+    auto path = std::make_shared<nav_msgs::Path>();
+    path->header = currentPathHeader_;
+    if (path->header.frame_id.empty())
+    {
+        path->header.frame_id = this->odomFrame_;
+    }
+    pathStore_.copyCurrentPath(path->poses);
+
+    std::atomic_store(&pathSnapshot_, std::shared_ptr<const nav_msgs::Path>(path));
+    snapshotDirty_ = false;
 }
 
 /**
@@ -207,36 +303,192 @@ nav_msgs::Path OdomTracker::getPath()
 */
 void OdomTracker::rtPublishPaths(ros::Time timestamp)
 {
-    if (robotBasePathPub_->trylock())
+    // the current path was already copied into the snapshot, it is handed to the publisher thread as it is
+    // (a snapshot not published yet is replaced by the newer one)
     {
-        nav_msgs::Path &msg = robotBasePathPub_->msg_;
-        ///  Copy trajectory
-
-        msg = baseTrajectory_;
-        msg.header.stamp = timestamp;
-        robotBasePathPub_->unlockAndPublish();
+        std::lock_guard<std::mutex> lock(pathPublisherMutex_);
+        pathToPublish_ = std::atomic_load(&pathSnapshot_);
     }
+    pathPublisherCondition_.notify_one();
 
     if (robotBasePathStackedPub_->trylock())
     {
         nav_msgs::Path &msg = robotBasePathStackedPub_->msg_;
         ///  Copy trajectory
 
-        msg = aggregatedStackPathMsg_;
+        msg.header.frame_id = this->odomFrame_;
         msg.header.stamp = timestamp;
+        pathStore_.copyStackedPath(msg.poses);
         robotBasePathStackedPub_->unlockAndPublish();
     }
 }
 
-void OdomTracker::updateAggregatedStackPath()
+/**
+******************************************************************************************************************
+* pathPublisherLoop()
+******************************************************************************************************************
+*/
+void OdomTracker::pathPublisherLoop()
 {
-    aggregatedStackPathMsg_.poses.clear();
-    for (auto &p : pathStack_)
+    std::unique_lock<std::mutex> lock(pathPublisherMutex_);
+    while (true)
     {
-        aggregatedStackPathMsg_.poses.insert(aggregatedStackPathMsg_.poses.end(), p.poses.begin(), p.poses.end());
+        pathPublisherCondition_.wait(lock, [this] { return pathPublisherStop_ || pathToPublish_; });
+        if (pathPublisherStop_)
+            return;
+
+        std::shared_ptr<const nav_msgs::Path> snapshot;
+        snapshot.swap(pathToPublish_);
+        lock.unlock();
+
+        robotBasePathPub_.publish(boost::shared_ptr<const nav_msgs::Path>(snapshot.get(), [snapshot](const nav_msgs::Path *) {}));
+
+        lock.lock();
     }
+}
 
-    aggregatedStackPathMsg_.header.frame_id = this->odomFrame_;
+/**
+******************************************************************************************************************
+* notifyPoseAppended()
+******************************************************************************************************************
+*/
+void OdomTracker::notifyPoseAppended(const geometry_msgs::PoseStamped &pose)
+{
+    // on reset the whole current path is sent anyway
+    if (!pendingDelta_.reset)
+    {
+        pendingDelta_.appended_poses.push_back(pose);
+    }
+    pendingDeltaChanges_ = true;
+    snapshotDirty_ = true;
+
+    if (sharedTrail_)
+    {
+        sharedTrail_->append(pose);
+    }
+}
+
+/**
+******************************************************************************************************************
+* notifyPoseRemoved()
+******************************************************************************************************************
+*/
+void OdomTracker::notifyPoseRemoved()
+{
+    if (!pendingDelta_.reset)
+    {
+        if (!pendingDelta_.appended_poses.empty())
+        {
+            // the subscribers have not received it yet
+            pendingDelta_.appended_poses.pop_back();
+        }
+        else
+        {
+            pendingDelta_.removed_poses++;
+        }
+    }
+    pendingDeltaChanges_ = true;
+    snapshotDirty_ = true;
+
+    if (sharedTrail_)
+    {
+        sharedTrail_->removeLast();
+    }
+}
+
+/**
+******************************************************************************************************************
+* notifyPathReset()
+******************************************************************************************************************
+*/
+void OdomTracker::notifyPathReset()
+{
+    this->resetPendingDelta();
+    pendingDeltaChanges_ = true;
+    snapshotDirty_ = true;
+
+    simplifier_.reset();
+
+    if (sharedTrail_)
+    {
+        std::vector<geometry_msgs::PoseStamped> poses;
+        pathStore_.copyCurrentPath(poses);
+        sharedTrail_->reset(poses);
+    }
+}
+
+void OdomTracker::resetPendingDelta()
+{
+    // the current path is copied when the delta is published
+    pendingDelta_.reset = true;
+    pendingDelta_.removed_poses = 0;
+    pendingDelta_.appended_poses.clear();
+}
+
+/**
+******************************************************************************************************************
+* trySimplifyLastPose()
+******************************************************************************************************************
+*/
+bool OdomTracker::trySimplifyLastPose(const geometry_msgs::PoseStamped &newPose)
+{
+    if (!simplifier_.simplifyLast(pathStore_, newPose))
+        return false;
+
+    this->notifyPoseRemoved();
+    this->notifyPoseAppended(newPose);
+    return true;
+}
+
+/**
+******************************************************************************************************************
+* enforcePathSizeLimit()
+******************************************************************************************************************
+*/
+void OdomTracker::enforcePathSizeLimit()
+{
+    if (maxPathPoses_ <= 0 || pathStore_.size() <= (size_t)maxPathPoses_)
+        return;
+
+    auto previousSize = pathStore_.size();
+    pathStore_.downsample();
+    this->notifyPathReset();
+
+    ROS_WARN_STREAM("[OdomTracker] max_path_poses reached, paths downsampled from " << previousSize << " to " << pathStore_.size() << " poses");
+}
+
+/**
+******************************************************************************************************************
+* publishPathDelta()
+******************************************************************************************************************
+*/
+void OdomTracker::publishPathDelta(ros::Time timestamp)
+{
+    if (!pendingDeltaChanges_)
+        return;
+
+    if (robotBasePathDeltaPub_.getNumSubscribers() == 0)
+    {
+        // nobody keeps a copy of the path, new subscribers start from a reset. Only the delta is reset,
+        // the path itself did not change
+        this->resetPendingDelta();
+        return;
+    }
+
+    if (pendingDelta_.reset)
+    {
+        pathStore_.copyCurrentPath(pendingDelta_.appended_poses);
+    }
+
+    pendingDelta_.header.frame_id = currentPathHeader_.frame_id.empty() ? this->odomFrame_ : currentPathHeader_.frame_id;
+    pendingDelta_.header.stamp = timestamp;
+    robotBasePathDeltaPub_.publish(pendingDelta_);
+
+    pendingDelta_.sequence++;
+    pendingDelta_.reset = false;
+    pendingDelta_.removed_poses = 0;
+    pendingDelta_.appended_poses.clear();
+    pendingDeltaChanges_ = false;
 }
 
 /**
@@ -252,17 +504,17 @@ bool OdomTracker::updateClearPath(const nav_msgs::Odometry &odom)
 
     base_pose.pose = odom.pose.pose;
     base_pose.header = odom.header;
-    baseTrajectory_.header = odom.header;
+    currentPathHeader_ = odom.header;
 
     bool acceptBackward = false;
     bool pullingerror = false;
-    if (baseTrajectory_.poses.empty())
+    if (pathStore_.currentEmpty())
     {
         acceptBackward = false;
     }
     else
     {
-        auto &prevPose = baseTrajectory_.poses.back().pose;
+        auto &prevPose = pathStore_.currentBack().pose;
         const geometry_msgs::Point &prevPoint = prevPose.position;
         double prevAngle = tf::getYaw(prevPose.orientation);
 
@@ -273,7 +525,7 @@ bool OdomTracker::updateClearPath(const nav_msgs::Odometry &odom)
         double lastpointdist = p2pDistance(prevPoint, currePoint);
         double goalAngleOffset = angles::shortest_angular_distance(prevAngle, currentAngle);
 
-        acceptBackward = !baseTrajectory_.poses.empty() && (lastpointdist > clearPointDistanceThreshold_ || goalAngleOffset > clearAngularDistanceThreshold_);
+        acceptBackward = !pathStore_.currentEmpty() && (lastpointdist > clearPointDistanceThreshold_ || goalAngleOffset > clearAngularDistanceThreshold_);
 
         pullingerror = lastpointdist > 2 * clearPointDistanceThreshold_;
     }
@@ -281,7 +533,9 @@ bool OdomTracker::updateClearPath(const nav_msgs::Odometry &odom)
     //ROS_INFO("Backwards, last distance: %lf < %lf accept: %d", dist, minPointDistanceBackwardThresh_, acceptBackward);
     if (acceptBackward)
     {
-        baseTrajectory_.poses.pop_back();
+        pathStore_.removeLast();
+        this->notifyPoseRemoved();
+        simplifier_.reset();
     }
     else if (pullingerror)
     {
@@ -306,18 +560,18 @@ bool OdomTracker::updateRecordPath(const nav_msgs::Odometry &odom)
 
     base_pose.pose = odom.pose.pose;
     base_pose.header = odom.header;
-    baseTrajectory_.header = odom.header;
+    currentPathHeader_ = odom.header;
 
     bool enqueueOdomMessage = false;
 
     double dist = -1;
-    if (baseTrajectory_.poses.empty())
+    if (pathStore_.currentEmpty())
     {
         enqueueOdomMessage = true;
     }
     else
     {
-        const auto &prevPose = baseTrajectory_.poses.back().pose;
+        const auto &prevPose = pathStore_.currentBack().pose;
         const geometry_msgs::Point &prevPoint = prevPose.position;
         double prevAngle = tf::getYaw(prevPose.orientation);
 
@@ -342,7 +596,12 @@ bool OdomTracker::updateRecordPath(const nav_msgs::Odometry &odom)
 
     if (enqueueOdomMessage)
     {
-        baseTrajectory_.poses.push_back(base_pose);
+        if (!trySimplifyLastPose(base_pose))
+        {
+            pathStore_.append(base_pose);
+            this->notifyPoseAppended(base_pose);
+            this->enforcePathSizeLimit();
+        }
     }
 
     return enqueueOdomMessage;
@@ -367,10 +626,35 @@ void OdomTracker::processOdometryMessage(const nav_msgs::Odometry &odom)
         updateClearPath(odom);
     }
 
+    if (sharedTrail_)
+    {
+        sharedTrail_->setFrameId(currentPathHeader_.frame_id);
+    }
+
+    // the full paths (snapshot and messages) are only copied at publish_rate
+    auto now = ros::Time::now();
+    bool publicationPeriodElapsed = publishRate_ <= 0 || lastPathPublication_.isZero() ||
+                                    (now - lastPathPublication_).toSec() >= 1.0 / publishRate_ || now < lastPathPublication_;
+
+    if (publicationPeriodElapsed)
+    {
+        if (snapshotDirty_)
+        {
+            updatePathSnapshot();
+        }
+        lastPathPublication_ = now;
+    }
+
     //ROS_WARN("odomTracker odometry callback");
     if (publishMessages)
     {
-        rtPublishPaths(odom.header.stamp);
+        // deltas are cheap
+        publishPathDelta(odom.header.stamp);
+
+        if (publicationPeriodElapsed)
+        {
+            rtPublishPaths(odom.header.stamp);
+        }
     }
 
     //ROS_INFO("odom_tracker m_mutex release");
@@ -0,0 +1,71 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <move_base_z_client_plugin/components/odom_tracker/path_simplifier.h>
+#include <angles/angles.h>
+#include <tf/transform_datatypes.h>
+
+namespace cl_move_base_z
+{
+namespace odom_tracker
+{
+PathSimplifier::PathSimplifier(double tolerance, double angularTolerance, double maxSegmentLength)
+    : tolerance_(tolerance), angularTolerance_(angularTolerance), maxSegmentLength_(maxSegmentLength)
+{
+}
+
+void PathSimplifier::reset()
+{
+    droppedPoses_.clear();
+}
+
+/**
+******************************************************************************************************************
+* simplifyLast()
+******************************************************************************************************************
+*/
+bool PathSimplifier::simplifyLast(PathStore &path, const geometry_msgs::PoseStamped &newPose)
+{
+    if (!isEnabled() || path.currentSize() < 2)
+    {
+        droppedPoses_.clear();
+        return false;
+    }
+
+    const auto &anchor = path.currentAt(path.currentSize() - 2);
+    const auto &anchorPoint = anchor.pose.position;
+    const auto &newPoint = newPose.pose.position;
+
+    double dx = newPoint.x - anchorPoint.x;
+    double dy = newPoint.y - anchorPoint.y;
+    if (maxSegmentLength_ > 0 && sqrt(dx * dx + dy * dy) > maxSegmentLength_)
+    {
+        droppedPoses_.clear();
+        return false;
+    }
+
+    double anchorAngle = tf::getYaw(anchor.pose.orientation);
+    double newAngle = tf::getYaw(newPose.pose.orientation);
+
+    // the last pose would be dropped too, all the dropped poses must be close to the segment anchor -> newPose
+    droppedPoses_.push_back(path.currentBack());
+    for (auto &dropped : droppedPoses_)
+    {
+        double droppedAngle = tf::getYaw(dropped.pose.orientation);
+        if (p2segmentDistance(dropped.pose.position, anchorPoint, newPoint) > tolerance_ ||
+            fabs(angles::shortest_angular_distance(anchorAngle, droppedAngle)) > angularTolerance_ ||
+            fabs(angles::shortest_angular_distance(newAngle, droppedAngle)) > angularTolerance_)
+        {
+            // the last pose is kept and becomes the new anchor
+            droppedPoses_.clear();
+            return false;
+        }
+    }
+
+    path.replaceLast(newPose);
+    return true;
+}
+} // namespace odom_tracker
+} // namespace cl_move_base_z
@@ -0,0 +1,129 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <move_base_z_client_plugin/components/odom_tracker/path_store.h>
+
+namespace cl_move_base_z
+{
+namespace odom_tracker
+{
+PathStore::PathStore()
+    : currentStart_(0)
+{
+}
+
+void PathStore::append(const geometry_msgs::PoseStamped &pose)
+{
+    poses_.push_back(pose);
+}
+
+void PathStore::removeLast()
+{
+    if (!currentEmpty())
+    {
+        poses_.pop_back();
+    }
+}
+
+void PathStore::replaceLast(const geometry_msgs::PoseStamped &pose)
+{
+    if (currentEmpty())
+    {
+        poses_.push_back(pose);
+    }
+    else
+    {
+        poses_.back() = pose;
+    }
+}
+
+void PathStore::setCurrentStart(const geometry_msgs::PoseStamped &pose)
+{
+    if (currentEmpty())
+    {
+        poses_.push_back(pose);
+    }
+    else
+    {
+        poses_[currentStart_] = pose;
+    }
+}
+
+void PathStore::clearCurrent()
+{
+    poses_.erase(poses_.begin() + currentStart_, poses_.end());
+}
+
+void PathStore::pushPath(const ros::Time &stamp)
+{
+    StackedPath segment;
+    segment.start = currentStart_;
+    segment.stamp = stamp;
+    segments_.push_back(segment);
+
+    currentStart_ = poses_.size();
+}
+
+bool PathStore::popPath()
+{
+    if (segments_.empty())
+        return false;
+
+    currentStart_ = segments_.back().start;
+    segments_.pop_back();
+    return true;
+}
+
+size_t PathStore::stackedPathSize(size_t index) const
+{
+    size_t end = (index + 1 < segments_.size()) ? segments_[index + 1].start : currentStart_;
+    return end - segments_[index].start;
+}
+
+ros::Time PathStore::stackedPathStamp(size_t index) const
+{
+    return segments_[index].stamp;
+}
+
+void PathStore::downsample()
+{
+    std::deque<geometry_msgs::PoseStamped> poses;
+
+    auto copyDecimated = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (i == begin || i + 1 == end || (i - begin) % 2 == 0)
+            {
+                poses.push_back(std::move(poses_[i]));
+            }
+        }
+    };
+
+    for (size_t k = 0; k < segments_.size(); k++)
+    {
+        size_t begin = segments_[k].start;
+        size_t end = (k + 1 < segments_.size()) ? segments_[k + 1].start : currentStart_;
+        segments_[k].start = poses.size();
+        copyDecimated(begin, end);
+    }
+
+    size_t begin = currentStart_;
+    currentStart_ = poses.size();
+    copyDecimated(begin, poses_.size());
+
+    poses_.swap(poses);
+}
+
+void PathStore::copyCurrentPath(std::vector<geometry_msgs::PoseStamped> &poses) const
+{
+    poses.assign(poses_.begin() + currentStart_, poses_.end());
+}
+
+void PathStore::copyStackedPath(std::vector<geometry_msgs::PoseStamped> &poses) const
+{
+    poses.assign(poses_.begin(), poses_.begin() + currentStart_);
+}
+} // namespace odom_tracker
+} // namespace cl_move_base_z
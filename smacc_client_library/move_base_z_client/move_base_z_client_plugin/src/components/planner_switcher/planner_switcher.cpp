@@ -5,11 +5,13 @@
  ******************************************************************************************************************/
 #include <move_base_z_client_plugin/components/planner_switcher/planner_switcher.h>
 #include <move_base_z_client_plugin/move_base_z_client_plugin.h>
+#include <std_msgs/String.h>
 
 namespace cl_move_base_z
 {
 
 PlannerSwitcher::PlannerSwitcher()
+    : multiplexing_(false)
 {
 }
 
@@ -18,6 +20,34 @@ void PlannerSwitcher::initialize(smacc::ISmaccClient *owner)
   auto client_ = dynamic_cast<ClMoveBaseZ *>(owner);
   ros::NodeHandle nh(client_->name_);
   dynrecofSub_ = nh.subscribe<dynamic_reconfigure::Config>("/move_base/parameter_updates", 1, boost::bind(&PlannerSwitcher::dynreconfCallback, this, _1));
+
+  // if move_base hosts the multiplexing planners, switching is just a (latched) mode message
+  std::string globalPlanner;
+  if (ros::param::get("/move_base/base_global_planner", globalPlanner) && globalPlanner == "multiplexing_planner/MultiplexingGlobalPlanner")
+  {
+    ROS_INFO("[PlannerSwitcher] move_base uses the multiplexing planners, planners will be switched through /move_base/planner_mode");
+    multiplexing_ = true;
+    plannerModePub_ = nh.advertise<std_msgs::String>("/move_base/planner_mode", 1, true /*latched*/);
+
+    ros::NodeHandle ackNh(client_->name_);
+    ackNh.setCallbackQueue(&modeAckQueue_);
+    modeAckSub_ = ackNh.subscribe("/move_base/planner_mode_ack", 1, &PlannerSwitcher::modeAckCallback, this);
+  }
+}
+
+void PlannerSwitcher::modeAckCallback(const std_msgs::String::ConstPtr &msg)
+{
+  acknowledgedMode_ = msg->data;
+}
+
+bool PlannerSwitcher::usesMultiplexingPlanner() const
+{
+  return multiplexing_;
+}
+
+const std::string& PlannerSwitcher::getMode() const
+{
+  return desired_mode_;
 }
 
 void PlannerSwitcher::setBackwardPlanner()
@@ -25,6 +55,7 @@ void PlannerSwitcher::setBackwardPlanner()
   ROS_INFO("[PlannerSwitcher] Planner Switcher: Trying to set BackwardPlanner");
   desired_global_planner_ = "backward_global_planner/BackwardGlobalPlanner";
   desired_local_planner_ = "backward_local_planner/BackwardLocalPlanner";
+  desired_mode_ = "backward";
   updatePlanners();
 }
 
@@ -33,6 +64,7 @@ void PlannerSwitcher::setForwardPlanner()
   ROS_INFO("[PlannerSwitcher] Planner Switcher: Trying to set ForwardPlanner");
   desired_global_planner_ = "forward_global_planner/ForwardGlobalPlanner";
   desired_local_planner_ = "forward_local_planner/ForwardLocalPlanner";
+  desired_mode_ = "forward";
   updatePlanners();
 }
 
@@ -42,6 +74,7 @@ void PlannerSwitcher::setPureSpinningPlanner()
   ROS_INFO("[PlannerSwitcher] Planner Switcher: Trying to set PureSpinningPlanner");
   desired_global_planner_ = "forward_global_planner/ForwardGlobalPlanner";
   desired_local_planner_ = "pure_spinning_local_planner/PureSpinningLocalPlanner";
+  desired_mode_ = "pure_spinning";
   updatePlanners();
 }
 
@@ -49,11 +82,34 @@ void PlannerSwitcher::setDefaultPlanners()
 {
   desired_global_planner_ = "navfn/NavfnROS";
   desired_local_planner_ = "base_local_planner/TrajectoryPlannerROS";
+  desired_mode_ = "default";
   updatePlanners();
 }
 
 void PlannerSwitcher::updatePlanners(bool subscribecallback)
 {
+  if (multiplexing_)
+  {
+    ROS_INFO_STREAM("[PlannerSwitcher] Setting planner mode: " << desired_mode_);
+    std_msgs::String modeMsg;
+    modeMsg.data = desired_mode_;
+    plannerModePub_.publish(modeMsg);
+
+    // the mode and the goals travel on different connections, the goal is not sent until move_base applied
+    // the mode
+    auto deadline = ros::WallTime::now() + ros::WallDuration(2.0);
+    while (acknowledgedMode_ != desired_mode_ && ros::ok() && ros::WallTime::now() < deadline)
+    {
+      modeAckQueue_.callAvailable(ros::WallDuration(0.01));
+    }
+
+    if (acknowledgedMode_ != desired_mode_)
+    {
+      ROS_WARN_STREAM("[PlannerSwitcher] move_base did not acknowledge the planner mode " << desired_mode_ << ", the next goal may be planned with the previous planners");
+    }
+    return;
+  }
+
   ROS_INFO_STREAM("[PlannerSwitcher] Setting global planner: " << desired_global_planner_);
   ROS_INFO_STREAM("[PlannerSwitcher] Setting local planner: " << desired_local_planner_);
 
@@ -80,6 +136,10 @@ void PlannerSwitcher::updatePlanners(bool subscribecallback)
 
 void PlannerSwitcher::dynreconfCallback(const dynamic_reconfigure::Config::ConstPtr &configuration_update)
 {
+  // the move_base planner plugins do not change in multiplexing mode
+  if (multiplexing_)
+    return;
+
   auto gp = std::find_if(configuration_update->strs.begin(), configuration_update->strs.begin(),
                          [&](const dynamic_reconfigure::StrParameter &p) {
                            return p.name == "base_global_planner" && p.value == desired_global_planner_;
@@ -13,36 +13,48 @@ Pose::Pose(std::string targetFrame, std::string referenceFrame)
     : poseFrameName_(targetFrame)
     , referenceFrame_(referenceFrame)
     , isInitialized(false)
+    , tfListener_(nullptr)
+    , transformSubscription_(0)
 {
     this->pose_.header.frame_id = referenceFrame_;
     ROS_INFO("[Pose] Creating Pose tracker component to track %s in the reference frame %s", targetFrame.c_str(), referenceFrame.c_str());
 }
 
-void Pose::waitTransformUpdate(ros::Rate r)
+Pose::~Pose()
 {
-    bool found = false;
-    while (ros::ok() && !found)
+    if (tfListener_ != nullptr)
     {
+        tfListener_->unsubscribeTransform(transformSubscription_);
+    }
+}
 
-        tf::StampedTransform transform;
-        try
-        {
-            this->tfListener_.lookupTransform(referenceFrame_, poseFrameName_,
-                                              ros::Time(0), transform);
+void Pose::initialize(smacc::ISmaccClient *owner)
+{
+    smacc::ISmaccComponent::initialize(owner);
 
-            {
-                std::lock_guard<std::mutex> guard(m_mutex_);
-                tf::poseTFToMsg(transform, this->pose_.pose);
-                this->pose_.header.stamp = transform.stamp_;
-                found = true;
-                this->isInitialized = true;
-            }
-        }
-        catch (tf::TransformException ex)
-        {
-            ROS_ERROR_THROTTLE(1, "[Component pose] is failing on pose update: %s", ex.what());
-        }
+    this->requiresComponent(tfListener_);
+    transformSubscription_ = tfListener_->subscribeTransform(referenceFrame_, poseFrameName_,
+                                                             [this](const geometry_msgs::TransformStamped &transform) {
+                                                                 this->onTransformUpdate(transform);
+                                                             });
+}
+
+void Pose::onTransformUpdate(const geometry_msgs::TransformStamped &transform)
+{
+    std::lock_guard<std::mutex> guard(m_mutex_);
+    this->pose_.pose.position.x = transform.transform.translation.x;
+    this->pose_.pose.position.y = transform.transform.translation.y;
+    this->pose_.pose.position.z = transform.transform.translation.z;
+    this->pose_.pose.orientation = transform.transform.rotation;
+    this->pose_.header.stamp = transform.header.stamp;
+    this->isInitialized = true;
+}
 
+void Pose::waitTransformUpdate(ros::Rate r)
+{
+    while (ros::ok() && !this->isInitialized)
+    {
+        this->update();
         r.sleep();
         ros::spinOnce();
     }
@@ -50,22 +62,10 @@ void Pose::waitTransformUpdate(ros::Rate r)
 
 void Pose::update()
 {
-    tf::StampedTransform transform;
-    try
-    {
-        this->tfListener_.lookupTransform(referenceFrame_, poseFrameName_,
-                                          ros::Time(0), transform);
-
-        {
-            std::lock_guard<std::mutex> guard(m_mutex_);
-            tf::poseTFToMsg(transform, this->pose_.pose);
-            this->pose_.header.stamp = transform.stamp_;
-            this->isInitialized = true;
-        }
-    }
-    catch (tf::TransformException ex)
+    auto transform = tfListener_->lookupTransform(referenceFrame_, poseFrameName_);
+    if (transform)
     {
-        ROS_ERROR_THROTTLE(1, "[Component pose] is failing on pose update: %s", ex.what());
+        this->onTransformUpdate(*transform);
     }
 }
 } // namespace cl_move_base_z
@@ -0,0 +1,498 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <move_base_z_client_plugin/components/waypoints_navigator/waypoint_route.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <ros/console.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace cl_move_base_z
+{
+namespace
+{
+struct WaypointFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+};
+
+struct WaypointFileRecord
+{
+    double values[7];
+};
+
+const char WAYPOINT_FILE_MAGIC[4] = {'S', 'M', 'W', 'P'};
+const uint32_t WAYPOINT_FILE_VERSION = 1;
+} // namespace
+
+WaypointRoute::WaypointRoute(double cellSize)
+    : root_(-1), random_(std::random_device()()), cellSize_(cellSize)
+{
+    clear();
+}
+
+/**
+******************************************************************************************************************
+* sequence
+******************************************************************************************************************
+*/
+const geometry_msgs::Pose &WaypointRoute::at(size_t index) const
+{
+    return nodes_[findNode(index)].pose;
+}
+
+void WaypointRoute::insert(size_t index, const geometry_msgs::Pose &pose)
+{
+    index = std::min(index, size());
+    int node = allocate(pose);
+
+    int l, r;
+    split(root_, index, l, r);
+    root_ = merge(merge(l, node), r);
+    nodes_[root_].parent = -1;
+
+    indexNode(node);
+}
+
+void WaypointRoute::erase(size_t index)
+{
+    if (index >= size())
+        return;
+
+    int l, m, r;
+    split(root_, index, l, m);
+    split(m, 1, m, r);
+    root_ = merge(l, r);
+    if (root_ >= 0)
+        nodes_[root_].parent = -1;
+
+    unindexNode(m);
+    freeNodes_.push_back(m);
+}
+
+void WaypointRoute::clear()
+{
+    nodes_.clear();
+    freeNodes_.clear();
+    root_ = -1;
+
+    cells_.clear();
+    cellBounds_.reset();
+}
+
+void WaypointRoute::assign(const std::vector<geometry_msgs::Pose> &poses)
+{
+    this->build(poses.size(), [&](size_t i, geometry_msgs::Pose &pose) { pose = poses[i]; });
+}
+
+void WaypointRoute::build(size_t count, std::function<void(size_t, geometry_msgs::Pose &)> getPose)
+{
+    clear();
+    nodes_.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto &node = nodes_[i];
+        getPose(i, node.pose);
+        node.visited = false;
+    }
+
+    root_ = buildBalanced(0, (int)count);
+    if (root_ < 0)
+        return;
+
+    nodes_[root_].parent = -1;
+
+    // the shape is balanced, random priorities are assigned in breadth first order from the highest to
+    // the lowest so that the heap property holds and later insertions keep the treap balanced
+    std::vector<uint32_t> priorities(count);
+    for (auto &p : priorities)
+        p = random_();
+    std::sort(priorities.begin(), priorities.end(), std::greater<uint32_t>());
+
+    std::deque<int> queue;
+    queue.push_back(root_);
+    size_t k = 0;
+    while (!queue.empty())
+    {
+        int t = queue.front();
+        queue.pop_front();
+        nodes_[t].priority = priorities[k++];
+        if (nodes_[t].left >= 0)
+            queue.push_back(nodes_[t].left);
+        if (nodes_[t].right >= 0)
+            queue.push_back(nodes_[t].right);
+    }
+
+    for (size_t i = 0; i < count; i++)
+        indexNode(i);
+}
+
+std::vector<geometry_msgs::Pose> WaypointRoute::toVector() const
+{
+    std::vector<geometry_msgs::Pose> poses;
+    poses.reserve(size());
+
+    // iterative in-order traversal
+    std::vector<int> stack;
+    int t = root_;
+    while (t >= 0 || !stack.empty())
+    {
+        while (t >= 0)
+        {
+            stack.push_back(t);
+            t = nodes_[t].left;
+        }
+
+        t = stack.back();
+        stack.pop_back();
+        poses.push_back(nodes_[t].pose);
+        t = nodes_[t].right;
+    }
+
+    return poses;
+}
+
+void WaypointRoute::setVisited(size_t index, bool visited)
+{
+    if (index < size())
+        nodes_[findNode(index)].visited = visited;
+}
+
+bool WaypointRoute::isVisited(size_t index) const
+{
+    return index < size() && nodes_[findNode(index)].visited;
+}
+
+void WaypointRoute::clearVisited()
+{
+    for (auto &node : nodes_)
+        node.visited = false;
+}
+
+/**
+******************************************************************************************************************
+* treap
+******************************************************************************************************************
+*/
+int WaypointRoute::allocate(const geometry_msgs::Pose &pose)
+{
+    int t;
+    if (!freeNodes_.empty())
+    {
+        t = freeNodes_.back();
+        freeNodes_.pop_back();
+    }
+    else
+    {
+        t = nodes_.size();
+        nodes_.emplace_back();
+    }
+
+    auto &node = nodes_[t];
+    node.pose = pose;
+    node.priority = random_();
+    node.left = node.right = node.parent = -1;
+    node.size = 1;
+    node.visited = false;
+    return t;
+}
+
+int WaypointRoute::findNode(size_t index) const
+{
+    int t = root_;
+    while (t >= 0)
+    {
+        size_t leftSize = nodeSize(nodes_[t].left);
+        if (index < leftSize)
+        {
+            t = nodes_[t].left;
+        }
+        else if (index == leftSize)
+        {
+            return t;
+        }
+        else
+        {
+            index -= leftSize + 1;
+            t = nodes_[t].right;
+        }
+    }
+
+    throw std::out_of_range("waypoint index out of range");
+}
+
+size_t WaypointRoute::rank(int node) const
+{
+    size_t r = nodeSize(nodes_[node].left);
+    int t = node;
+    while (nodes_[t].parent >= 0)
+    {
+        int p = nodes_[t].parent;
+        if (nodes_[p].right == t)
+            r += nodeSize(nodes_[p].left) + 1;
+        t = p;
+    }
+    return r;
+}
+
+void WaypointRoute::update(int t)
+{
+    auto &node = nodes_[t];
+    node.size = 1 + nodeSize(node.left) + nodeSize(node.right);
+    if (node.left >= 0)
+        nodes_[node.left].parent = t;
+    if (node.right >= 0)
+        nodes_[node.right].parent = t;
+}
+
+// l gets the first k nodes of t and r the rest
+void WaypointRoute::split(int t, size_t k, int &l, int &r)
+{
+    if (t < 0)
+    {
+        l = r = -1;
+        return;
+    }
+
+    size_t leftSize = nodeSize(nodes_[t].left);
+    if (leftSize < k)
+    {
+        int right;
+        split(nodes_[t].right, k - leftSize - 1, right, r);
+        nodes_[t].right = right;
+        l = t;
+    }
+    else
+    {
+        int left;
+        split(nodes_[t].left, k, l, left);
+        nodes_[t].left = left;
+        r = t;
+    }
+
+    update(t);
+    nodes_[t].parent = -1;
+}
+
+int WaypointRoute::merge(int l, int r)
+{
+    if (l < 0)
+        return r;
+    if (r < 0)
+        return l;
+
+    if (nodes_[l].priority > nodes_[r].priority)
+    {
+        nodes_[l].right = merge(nodes_[l].right, r);
+        update(l);
+        return l;
+    }
+    else
+    {
+        nodes_[r].left = merge(l, nodes_[r].left);
+        update(r);
+        return r;
+    }
+}
+
+int WaypointRoute::buildBalanced(int lo, int hi)
+{
+    if (lo >= hi)
+        return -1;
+
+    int mid = lo + (hi - lo) / 2;
+    auto &node = nodes_[mid];
+    node.left = buildBalanced(lo, mid);
+    node.right = buildBalanced(mid + 1, hi);
+    node.parent = -1;
+    update(mid);
+    return mid;
+}
+
+/**
+******************************************************************************************************************
+* spatial index
+******************************************************************************************************************
+*/
+void WaypointRoute::cellOf(const geometry_msgs::Pose &pose, int &cx, int &cy) const
+{
+    cx = (int)std::floor(pose.position.x / cellSize_);
+    cy = (int)std::floor(pose.position.y / cellSize_);
+}
+
+void WaypointRoute::indexNode(int node)
+{
+    int cx, cy;
+    cellOf(nodes_[node].pose, cx, cy);
+    cells_[gridCellKey(cx, cy)].push_back(node);
+    cellBounds_.expand(cx, cy);
+}
+
+void WaypointRoute::unindexNode(int node)
+{
+    int cx, cy;
+    cellOf(nodes_[node].pose, cx, cy);
+
+    auto it = cells_.find(gridCellKey(cx, cy));
+    if (it == cells_.end())
+        return;
+
+    auto &cell = it->second;
+    auto pos = std::find(cell.begin(), cell.end(), node);
+    if (pos != cell.end())
+    {
+        *pos = cell.back();
+        cell.pop_back();
+    }
+
+    if (cell.empty())
+        cells_.erase(it);
+}
+
+long WaypointRoute::nearestUnvisited(double x, double y) const
+{
+    if (empty())
+        return -1;
+
+    geometry_msgs::Pose query;
+    query.position.x = x;
+    query.position.y = y;
+    int cx, cy;
+    cellOf(query, cx, cy);
+
+    int best = -1;
+    double bestDist2 = std::numeric_limits<double>::max();
+
+    auto visitCell = [&](int ix, int iy) {
+        auto it = cells_.find(gridCellKey(ix, iy));
+        if (it == cells_.end())
+            return;
+
+        for (int t : it->second)
+        {
+            auto &node = nodes_[t];
+            if (node.visited)
+                continue;
+
+            double dx = node.pose.position.x - x;
+            double dy = node.pose.position.y - y;
+            double dist2 = dx * dx + dy * dy;
+            if (dist2 < bestDist2)
+            {
+                bestDist2 = dist2;
+                best = t;
+            }
+        }
+    };
+
+    // rings of cells around the query, until no closer waypoint can be found in the next ring: every cell of a
+    // ring is at least (ring - 1) cells away from the query
+    auto closerThanRing = [&](int ring) {
+        double ringDist = (ring - 1) * cellSize_;
+        return best >= 0 && ringDist > 0 && ringDist * ringDist > bestDist2;
+    };
+
+    visitCellRings(cx, cy, cellBounds_, visitCell, closerThanRing);
+
+    if (best < 0)
+        return -1;
+
+    return rank(best);
+}
+
+/**
+******************************************************************************************************************
+* binary file
+******************************************************************************************************************
+*/
+bool saveWaypointsBinary(const std::string &filepath, const WaypointRoute &route)
+{
+    std::ofstream ofs(filepath.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!ofs.good())
+    {
+        ROS_ERROR("[WaypointRoute] could not open %s for writing", filepath.c_str());
+        return false;
+    }
+
+    WaypointFileHeader header;
+    std::memcpy(header.magic, WAYPOINT_FILE_MAGIC, sizeof(header.magic));
+    header.version = WAYPOINT_FILE_VERSION;
+    header.count = route.size();
+    ofs.write((const char *)&header, sizeof(header));
+
+    for (auto &pose : route.toVector())
+    {
+        WaypointFileRecord record = {{pose.position.x, pose.position.y, pose.position.z,
+                                      pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w}};
+        ofs.write((const char *)&record, sizeof(record));
+    }
+
+    return ofs.good();
+}
+
+bool loadWaypointsBinary(const std::string &filepath, WaypointRoute &route)
+{
+    using namespace boost::interprocess;
+
+    try
+    {
+        file_mapping file(filepath.c_str(), read_only);
+        mapped_region region(file, read_only);
+        region.advise(mapped_region::advice_sequential);
+
+        auto data = (const char *)region.get_address();
+        size_t fileSize = region.get_size();
+
+        if (fileSize < sizeof(WaypointFileHeader))
+            return false;
+
+        WaypointFileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, WAYPOINT_FILE_MAGIC, sizeof(header.magic)) != 0)
+            return false;
+
+        if (header.version != WAYPOINT_FILE_VERSION)
+        {
+            ROS_ERROR("[WaypointRoute] unsupported waypoints file version %u: %s", header.version, filepath.c_str());
+            return false;
+        }
+
+        if ((fileSize - sizeof(header)) / sizeof(WaypointFileRecord) < header.count)
+        {
+            ROS_ERROR("[WaypointRoute] truncated waypoints file: %s", filepath.c_str());
+            return false;
+        }
+
+        auto records = data + sizeof(header);
+        route.build(header.count, [&](size_t i, geometry_msgs::Pose &pose) {
+            WaypointFileRecord record;
+            std::memcpy(&record, records + i * sizeof(WaypointFileRecord), sizeof(record));
+            pose.position.x = record.values[0];
+            pose.position.y = record.values[1];
+            pose.position.z = record.values[2];
+            pose.orientation.x = record.values[3];
+            pose.orientation.y = record.values[4];
+            pose.orientation.z = record.values[5];
+            pose.orientation.w = record.values[6];
+        });
+    }
+    catch (const interprocess_exception &ex)
+    {
+        ROS_ERROR("[WaypointRoute] could not map %s: %s", filepath.c_str(), ex.what());
+        return false;
+    }
+
+    return true;
+}
+} // namespace cl_move_base_z
@@ -4,7 +4,9 @@
 #include <move_base_z_client_plugin/components/odom_tracker/odom_tracker.h>
 #include <move_base_z_client_plugin/components/pose/cp_pose.h>
 
+#include <algorithm>
 #include <fstream>
+#include <nav_msgs/Path.h>
 #include <ros/ros.h>
 #include <yaml-cpp/yaml.h>
 #include <tf/transform_datatypes.h>
@@ -13,22 +15,94 @@ namespace cl_move_base_z
 {
 WaypointNavigator::WaypointNavigator()
     : currentWaypoint_(0),
-      waypoints_(0)
+      lookAhead_(0)
 {
 }
 
 void WaypointNavigator::onGoalReached(ClMoveBaseZ::ResultConstPtr &res)
 {
   waypointsEventDispatcher.postWaypointEvent(currentWaypoint_);
+  waypoints_.setVisited(currentWaypoint_, true);
   currentWaypoint_++;
   this->succeddedConnection_.disconnect();
 }
 
 void WaypointNavigator::sendNextGoal()
+{
+  auto plannerSwitcher = client_->getComponent<PlannerSwitcher>();
+  bool wait = this->requiresPlannerSwitch() && !plannerSwitcher->usesMultiplexingPlanner();
+  this->setWaypointPlanners();
+
+  if (wait)
+  {
+    ros::spinOnce();
+    ros::Duration(5).sleep();
+  }
+
+  this->sendNextGoalWithCurrentPlanners();
+}
+
+void WaypointNavigator::setLookAhead(int waypoints)
+{
+  lookAhead_ = std::max(waypoints, 0);
+
+  if (lookAhead_ > 0 && !lookAheadGoalsPub_)
+  {
+    ros::NodeHandle nh;
+    lookAheadGoalsPub_ = nh.advertise<nav_msgs::Path>(client_->name_ + "/ForwardGlobalPlanner/lookahead_goals", 1, true /*latched*/);
+  }
+}
+
+int WaypointNavigator::getLookAhead() const
+{
+  return lookAhead_;
+}
+
+void WaypointNavigator::setWaypointPlanners()
+{
+  auto plannerSwitcher = client_->getComponent<PlannerSwitcher>();
+  if (lookAhead_ > 0)
+  {
+    if (this->requiresPlannerSwitch())
+      plannerSwitcher->setForwardPlanner();
+  }
+  else
+  {
+    plannerSwitcher->setDefaultPlanners();
+  }
+}
+
+bool WaypointNavigator::requiresPlannerSwitch() const
+{
+  // the default planners are always requested again, as they were before the look-ahead mode
+  auto plannerSwitcher = client_->getComponent<PlannerSwitcher>();
+  return lookAhead_ == 0 || plannerSwitcher->getMode() != "forward";
+}
+
+void WaypointNavigator::publishLookAheadGoals(const std::string &frameId)
+{
+  // the goal being sent and the next lookAhead_ waypoints
+  nav_msgs::Path goals;
+  goals.header.frame_id = frameId;
+  goals.header.stamp = ros::Time::now();
+
+  long last = std::min<long>(currentWaypoint_ + lookAhead_, (long)waypoints_.size() - 1);
+  for (long i = currentWaypoint_; i <= last; i++)
+  {
+    geometry_msgs::PoseStamped goal;
+    goal.header = goals.header;
+    goal.pose = waypoints_.at(i);
+    goals.poses.push_back(goal);
+  }
+
+  lookAheadGoalsPub_.publish(goals);
+}
+
+void WaypointNavigator::sendNextGoalWithCurrentPlanners()
 {
   if (currentWaypoint_ >= 0 && currentWaypoint_ < waypoints_.size())
   {
-    auto &next = waypoints_[currentWaypoint_];
+    auto next = waypoints_.at(currentWaypoint_);
 
     auto odomTracker = client_->getComponent<cl_move_base_z::odom_tracker::OdomTracker>();
     auto p = client_->getComponent<cl_move_base_z::Pose>();
@@ -39,12 +113,6 @@ void WaypointNavigator::sendNextGoal()
     goal.target_pose.header.stamp = ros::Time::now();
     goal.target_pose.pose = next;
 
-    auto plannerSwitcher = client_->getComponent<PlannerSwitcher>();
-    plannerSwitcher->setDefaultPlanners();
-
-    ros::spinOnce();
-    ros::Duration(5).sleep();
-
     if (odomTracker != nullptr)
     {
       odomTracker->pushPath();
@@ -52,6 +120,11 @@ void WaypointNavigator::sendNextGoal()
       odomTracker->setWorkingMode(cl_move_base_z::odom_tracker::WorkingMode::RECORD_PATH);
     }
 
+    if (lookAhead_ > 0)
+    {
+      this->publishLookAheadGoals(goal.target_pose.header.frame_id);
+    }
+
     this->succeddedConnection_ = client_->onSucceeded(&WaypointNavigator::onGoalReached, this);
     client_->sendGoal(goal);
   }
@@ -61,39 +134,47 @@ void WaypointNavigator::insertWaypoint(int index, geometry_msgs::Pose &newpose)
 {
   if (index >= 0 && index <= waypoints_.size())
   {
-    waypoints_.insert(waypoints_.begin(), index, newpose);
+    waypoints_.insert(index, newpose);
+
+    // the current waypoint keeps being the same pose
+    if (index < currentWaypoint_)
+      currentWaypoint_++;
   }
 }
 
 void WaypointNavigator::setWaypoints(const std::vector<geometry_msgs::Pose> &waypoints)
 {
-  this->waypoints_ = waypoints;
+  this->waypoints_.assign(waypoints);
 }
 
 void WaypointNavigator::setWaypoints(const std::vector<Pose2D> &waypoints)
 {
-  this->waypoints_.clear();
-  for (auto &p : waypoints)
-  {
-    geometry_msgs::Pose pose;
+  this->waypoints_.build(waypoints.size(), [&](size_t i, geometry_msgs::Pose &pose) {
+    auto &p = waypoints[i];
     pose.position.x = p.x_;
     pose.position.y = p.y_;
     pose.position.z = 0.0;
     pose.orientation = tf::createQuaternionMsgFromYaw(p.yaw_);
-
-    this->waypoints_.push_back(pose);
-  }
+  });
 }
 
 void WaypointNavigator::removeWaypoint(int index)
 {
   if (index >= 0 && index < waypoints_.size())
   {
-    waypoints_.erase(waypoints_.begin() + index);
+    waypoints_.erase(index);
+
+    if (index < currentWaypoint_)
+      currentWaypoint_--;
   }
 }
 
-const std::vector<geometry_msgs::Pose> &WaypointNavigator::getWaypoints() const
+std::vector<geometry_msgs::Pose> WaypointNavigator::getWaypoints() const
+{
+  return waypoints_.toVector();
+}
+
+const WaypointRoute &WaypointNavigator::getRoute() const
 {
   return waypoints_;
 }
@@ -103,16 +184,50 @@ long WaypointNavigator::getCurrentWaypointIndex() const
   return currentWaypoint_;
 }
 
+bool WaypointNavigator::resumeFromNearestUnvisitedWaypoint()
+{
+  auto p = client_->getComponent<cl_move_base_z::Pose>();
+  if (p == nullptr || !p->isInitialized)
+  {
+    ROS_WARN("[WaypointNavigator] cannot resume from the nearest waypoint, the robot pose is not available");
+    return false;
+  }
+
+  auto pose = p->toPoseMsg();
+  long nearest = waypoints_.nearestUnvisited(pose.position.x, pose.position.y);
+  if (nearest < 0)
+  {
+    ROS_WARN("[WaypointNavigator] cannot resume, all the waypoints were already reached");
+    return false;
+  }
+
+  ROS_INFO("[WaypointNavigator] resuming from waypoint %ld (it was %d)", nearest, currentWaypoint_);
+  currentWaypoint_ = nearest;
+  return true;
+}
+
+bool WaypointNavigator::saveWayPointsToBinaryFile(std::string filepath) const
+{
+  return saveWaypointsBinary(filepath, waypoints_);
+}
+
 #define HAVE_NEW_YAMLCPP
 void WaypointNavigator::loadWayPointsFromFile(std::string filepath)
 {
-  this->waypoints_.clear();
   std::ifstream ifs(filepath.c_str(), std::ifstream::in);
   if (ifs.good() == false)
   {
     throw std::string("Waypoints file not found");
   }
 
+  // binary route files are memory mapped and loaded without parsing
+  if (loadWaypointsBinary(filepath, this->waypoints_))
+  {
+    ROS_INFO_STREAM("Loaded " << this->waypoints_.size() << " waypoints from binary route file.");
+    return;
+  }
+
+  std::vector<geometry_msgs::Pose> waypoints;
   try
   {
 
@@ -149,14 +264,14 @@ void WaypointNavigator::loadWayPointsFromFile(std::string filepath)
           wp.orientation.z = (*wp_node)[i]["orientation"]["z"].as<double>();
           wp.orientation.w = (*wp_node)[i]["orientation"]["w"].as<double>();
 
-          this->waypoints_.push_back(wp);
+          waypoints.push_back(wp);
         }
         catch (...)
         {
           ROS_ERROR("parsing waypoint file, syntax error in point %d", i);
         }
       }
-      ROS_INFO_STREAM("Parsed " << this->waypoints_.size() << " waypoints.");
+      ROS_INFO_STREAM("Parsed " << waypoints.size() << " waypoints.");
     }
     else
     {
@@ -167,5 +282,7 @@ void WaypointNavigator::loadWayPointsFromFile(std::string filepath)
   {
     ROS_ERROR_STREAM("Error loading the Waypoints YAML file. Incorrect syntax: " << ex.what());
   }
+
+  this->waypoints_.assign(waypoints);
 }
 } // namespace cl_move_base_z
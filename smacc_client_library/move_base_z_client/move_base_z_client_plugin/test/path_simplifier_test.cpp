@@ -0,0 +1,169 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <move_base_z_client_plugin/components/odom_tracker/path_simplifier.h>
+#include <gtest/gtest.h>
+
+using namespace cl_move_base_z::odom_tracker;
+
+const double TOLERANCE = 0.01;
+const double ANGULAR_TOLERANCE = 0.05;
+const double MAX_SEGMENT_LENGTH = 0.5;
+
+geometry_msgs::PoseStamped makePose(double x, double y, double yaw)
+{
+  geometry_msgs::PoseStamped pose;
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  pose.pose.orientation.z = sin(yaw / 2);
+  pose.pose.orientation.w = cos(yaw / 2);
+  return pose;
+}
+
+// same as the odom tracker record mode: the pose is appended unless it replaces the last one
+void record(PathSimplifier &simplifier, PathStore &store, const std::vector<geometry_msgs::PoseStamped> &poses)
+{
+  for (auto &pose : poses)
+  {
+    if (!simplifier.simplifyLast(store, pose))
+      store.append(pose);
+  }
+}
+
+// largest distance from a recorded pose to the simplified path
+double maxDeviation(const std::vector<geometry_msgs::PoseStamped> &recorded, const PathStore &store)
+{
+  double maxDistance = 0;
+  for (auto &pose : recorded)
+  {
+    double distance = std::numeric_limits<double>::max();
+    for (size_t i = 0; i + 1 < store.currentSize(); i++)
+    {
+      distance = std::min(distance, p2segmentDistance(pose.pose.position, store.currentAt(i).pose.position,
+                                                      store.currentAt(i + 1).pose.position));
+    }
+    maxDistance = std::max(maxDistance, distance);
+  }
+  return maxDistance;
+}
+
+TEST(PathSimplifierTest, noisyStraightPathStaysWithinTolerance)
+{
+  std::vector<geometry_msgs::PoseStamped> recorded;
+  for (int i = 0; i <= 2000; i++)
+    recorded.push_back(makePose(i * 0.01, 0.004 * sin(i * 0.7), 0));
+
+  PathSimplifier simplifier(TOLERANCE, ANGULAR_TOLERANCE, MAX_SEGMENT_LENGTH);
+  PathStore store;
+  record(simplifier, store, recorded);
+
+  EXPECT_LE(maxDeviation(recorded, store), TOLERANCE);
+
+  // 20 meters in segments of at most 0.5 meters
+  EXPECT_LT(store.currentSize(), 100);
+  EXPECT_EQ(store.currentFront().pose.position.x, recorded.front().pose.position.x);
+  EXPECT_EQ(store.currentBack().pose.position.x, recorded.back().pose.position.x);
+
+  for (size_t i = 0; i + 1 < store.currentSize(); i++)
+  {
+    double dx = store.currentAt(i + 1).pose.position.x - store.currentAt(i).pose.position.x;
+    EXPECT_LE(dx, MAX_SEGMENT_LENGTH + 1e-9);
+  }
+}
+
+TEST(PathSimplifierTest, curvedPathStaysWithinTolerance)
+{
+  // arc of radius 2 meters, the poses are oriented along the path
+  std::vector<geometry_msgs::PoseStamped> recorded;
+  for (int i = 0; i <= 1500; i++)
+  {
+    double angle = i * 0.002;
+    recorded.push_back(makePose(2 * sin(angle), 2 - 2 * cos(angle), angle));
+  }
+
+  PathSimplifier simplifier(TOLERANCE, ANGULAR_TOLERANCE, MAX_SEGMENT_LENGTH);
+  PathStore store;
+  record(simplifier, store, recorded);
+
+  EXPECT_LE(maxDeviation(recorded, store), TOLERANCE);
+  EXPECT_LT(store.currentSize(), recorded.size() / 4);
+
+  // the kept poses never turn more than the angular tolerance (twice: anchor and new pose) in a segment
+  for (size_t i = 0; i + 1 < store.currentSize(); i++)
+  {
+    double yaw0 = 2 * atan2(store.currentAt(i).pose.orientation.z, store.currentAt(i).pose.orientation.w);
+    double yaw1 = 2 * atan2(store.currentAt(i + 1).pose.orientation.z, store.currentAt(i + 1).pose.orientation.w);
+    EXPECT_LE(fabs(yaw1 - yaw0), 2 * ANGULAR_TOLERANCE + 1e-9);
+  }
+}
+
+TEST(PathSimplifierTest, slowDriftIsBoundedByAllTheDroppedPoses)
+{
+  // the pose drifts sideways with a constant orientation: each new pose is close to the line of the previous
+  // one, but the error accumulates along the segment
+  std::vector<geometry_msgs::PoseStamped> recorded;
+  for (int i = 0; i <= 1000; i++)
+  {
+    double angle = i * 0.001;
+    recorded.push_back(makePose(2.5 * sin(angle), 2.5 - 2.5 * cos(angle), 0));
+  }
+
+  PathSimplifier simplifier(TOLERANCE, ANGULAR_TOLERANCE, 2.0);
+  PathStore store;
+  record(simplifier, store, recorded);
+
+  EXPECT_LE(maxDeviation(recorded, store), TOLERANCE);
+}
+
+TEST(PathSimplifierTest, disabledWithZeroTolerance)
+{
+  std::vector<geometry_msgs::PoseStamped> recorded;
+  for (int i = 0; i < 100; i++)
+    recorded.push_back(makePose(i * 0.01, 0, 0));
+
+  PathSimplifier simplifier;
+  PathStore store;
+  record(simplifier, store, recorded);
+
+  EXPECT_FALSE(simplifier.isEnabled());
+  EXPECT_EQ(store.currentSize(), recorded.size());
+}
+
+TEST(PathSimplifierTest, noSegmentLengthLimitByDefault)
+{
+  std::vector<geometry_msgs::PoseStamped> recorded;
+  for (int i = 0; i <= 2000; i++)
+    recorded.push_back(makePose(i * 0.01, 0, 0));
+
+  PathSimplifier simplifier(TOLERANCE, ANGULAR_TOLERANCE);
+  PathStore store;
+  record(simplifier, store, recorded);
+
+  // a straight line is a single segment
+  EXPECT_EQ(store.currentSize(), 2);
+  EXPECT_EQ(store.currentBack().pose.position.x, recorded.back().pose.position.x);
+}
+
+TEST(PathSimplifierTest, resetStartsANewSegment)
+{
+  PathSimplifier simplifier(TOLERANCE, ANGULAR_TOLERANCE, MAX_SEGMENT_LENGTH);
+  PathStore store;
+  record(simplifier, store, {makePose(0, 0, 0), makePose(0.1, 0, 0), makePose(0.2, 0, 0)});
+  ASSERT_EQ(store.currentSize(), 2);
+
+  // the last pose moved out of the line: the poses dropped before the removal must not be checked against it
+  store.removeLast();
+  simplifier.reset();
+  record(simplifier, store, {makePose(0.1, 0.05, 0), makePose(0.2, 0.1, 0)});
+
+  EXPECT_EQ(store.currentSize(), 2);
+  EXPECT_EQ(store.currentBack().pose.position.y, 0.1);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <move_base_z_client_plugin/components/odom_tracker/path_store.h>
+#include <gtest/gtest.h>
+
+using namespace cl_move_base_z::odom_tracker;
+
+geometry_msgs::PoseStamped makePose(double x, double y = 0)
+{
+  geometry_msgs::PoseStamped pose;
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  pose.pose.orientation.w = 1;
+  return pose;
+}
+
+void appendPoses(PathStore &store, int count, double firstX)
+{
+  for (int i = 0; i < count; i++)
+    store.append(makePose(firstX + i));
+}
+
+TEST(PathStoreTest, pushAndPopOnlyMoveTheBoundary)
+{
+  PathStore store;
+  appendPoses(store, 5, 0);
+  store.pushPath(ros::Time(1, 0));
+  appendPoses(store, 3, 100);
+
+  ASSERT_EQ(store.stackSize(), 1);
+  ASSERT_EQ(store.stackedPathSize(0), 5);
+  ASSERT_EQ(store.stackedPathStamp(0), ros::Time(1, 0));
+  ASSERT_EQ(store.currentSize(), 3);
+  ASSERT_EQ(store.currentFront().pose.position.x, 100);
+  ASSERT_EQ(store.size(), 8);
+
+  std::vector<geometry_msgs::PoseStamped> stacked;
+  store.copyStackedPath(stacked);
+  ASSERT_EQ(stacked.size(), 5);
+  ASSERT_EQ(stacked.back().pose.position.x, 4);
+
+  // the stacked path is prepended to the current path
+  ASSERT_TRUE(store.popPath());
+  ASSERT_EQ(store.stackSize(), 0);
+  ASSERT_EQ(store.currentSize(), 8);
+  ASSERT_EQ(store.currentFront().pose.position.x, 0);
+  ASSERT_EQ(store.currentBack().pose.position.x, 102);
+
+  ASSERT_FALSE(store.popPath());
+}
+
+TEST(PathStoreTest, currentPathEditsDoNotTouchTheStack)
+{
+  PathStore store;
+  appendPoses(store, 4, 0);
+  store.pushPath(ros::Time(1, 0));
+
+  // removing from an empty current path must not remove stacked poses
+  store.removeLast();
+  ASSERT_EQ(store.stackedPosesCount(), 4);
+
+  store.setCurrentStart(makePose(50));
+  ASSERT_EQ(store.currentSize(), 1);
+  appendPoses(store, 2, 60);
+  store.setCurrentStart(makePose(55));
+  ASSERT_EQ(store.currentFront().pose.position.x, 55);
+  ASSERT_EQ(store.currentSize(), 3);
+
+  store.replaceLast(makePose(70));
+  ASSERT_EQ(store.currentBack().pose.position.x, 70);
+
+  store.clearCurrent();
+  ASSERT_TRUE(store.currentEmpty());
+  ASSERT_EQ(store.size(), 4);
+}
+
+TEST(PathStoreTest, downsampleKeepsTheEndsOfEachPath)
+{
+  PathStore store;
+  appendPoses(store, 10, 0);
+  store.pushPath(ros::Time(1, 0));
+  appendPoses(store, 7, 100);
+
+  store.downsample();
+
+  ASSERT_EQ(store.stackSize(), 1);
+  ASSERT_EQ(store.stackedPathSize(0), 6); // 0 2 4 6 8 9
+  ASSERT_EQ(store.currentSize(), 4);      // 100 102 104 106
+
+  std::vector<geometry_msgs::PoseStamped> stacked;
+  store.copyStackedPath(stacked);
+  ASSERT_EQ(stacked.front().pose.position.x, 0);
+  ASSERT_EQ(stacked.back().pose.position.x, 9);
+
+  ASSERT_EQ(store.currentFront().pose.position.x, 100);
+  ASSERT_EQ(store.currentBack().pose.position.x, 106);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
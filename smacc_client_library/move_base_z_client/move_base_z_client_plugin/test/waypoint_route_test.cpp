@@ -0,0 +1,147 @@
+/*****************************************************************************************************************
+ * ReelRobotix Inc. - Software License Agreement      Copyright (c) 2018
+ * 	 Authors: Pablo Inigo Blasco, Brett Aldrich
+ *
+ ******************************************************************************************************************/
+#include <move_base_z_client_plugin/components/waypoints_navigator/waypoint_route.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace cl_move_base_z;
+
+geometry_msgs::Pose makePose(double x, double y)
+{
+  geometry_msgs::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.orientation.w = 1;
+  return pose;
+}
+
+void expectSameRoute(const WaypointRoute &route, const std::vector<geometry_msgs::Pose> &reference)
+{
+  ASSERT_EQ(route.size(), reference.size());
+
+  auto poses = route.toVector();
+  for (size_t i = 0; i < reference.size(); i++)
+  {
+    EXPECT_EQ(poses[i].position.x, reference[i].position.x);
+    EXPECT_EQ(route.at(i).position.y, reference[i].position.y);
+  }
+}
+
+TEST(WaypointRouteTest, insertAndEraseMatchAVector)
+{
+  std::mt19937 random(1);
+
+  std::vector<geometry_msgs::Pose> reference;
+  for (int i = 0; i < 1000; i++)
+    reference.push_back(makePose(i * 0.3, (i % 7) * 0.5));
+
+  WaypointRoute route;
+  route.assign(reference);
+  expectSameRoute(route, reference);
+
+  for (int i = 0; i < 20000; i++)
+  {
+    if (random() % 3 < 2 || reference.empty())
+    {
+      size_t index = random() % (reference.size() + 1);
+      auto pose = makePose((random() % 1000) * 0.1, (random() % 1000) * 0.1);
+      reference.insert(reference.begin() + index, pose);
+      route.insert(index, pose);
+    }
+    else
+    {
+      size_t index = random() % reference.size();
+      reference.erase(reference.begin() + index);
+      route.erase(index);
+    }
+
+    if (i % 997 == 0)
+      expectSameRoute(route, reference);
+  }
+
+  expectSameRoute(route, reference);
+}
+
+TEST(WaypointRouteTest, nearestUnvisitedMatchesTheLinearScan)
+{
+  std::mt19937 random(2);
+
+  std::vector<geometry_msgs::Pose> reference;
+  for (int i = 0; i < 2000; i++)
+    reference.push_back(makePose((random() % 1000) * 0.1, (random() % 1000) * 0.1));
+
+  WaypointRoute route;
+  route.assign(reference);
+  for (size_t i = 0; i < reference.size(); i += 3)
+    route.setVisited(i, true);
+
+  for (int q = 0; q < 200; q++)
+  {
+    double x = (random() % 1200) * 0.1 - 10;
+    double y = (random() % 1200) * 0.1 - 10;
+
+    double bestDistance = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < reference.size(); i++)
+    {
+      if (i % 3 == 0)
+        continue;
+
+      double dx = reference[i].position.x - x;
+      double dy = reference[i].position.y - y;
+      bestDistance = std::min(bestDistance, dx * dx + dy * dy);
+    }
+
+    long nearest = route.nearestUnvisited(x, y);
+    ASSERT_GE(nearest, 0);
+    EXPECT_FALSE(route.isVisited(nearest));
+
+    double dx = reference[nearest].position.x - x;
+    double dy = reference[nearest].position.y - y;
+    EXPECT_NEAR(dx * dx + dy * dy, bestDistance, 1e-9);
+  }
+
+  // a million cells away: only the rings that overlap the waypoints are scanned
+  long farthest = route.nearestUnvisited(1e6, 1e6);
+  ASSERT_GE(farthest, 0);
+  EXPECT_FALSE(route.isVisited(farthest));
+
+  route.clearVisited();
+  EXPECT_EQ(route.nearestUnvisited(reference[0].position.x, reference[0].position.y), 0);
+
+  for (size_t i = 0; i < route.size(); i++)
+    route.setVisited(i, true);
+  EXPECT_EQ(route.nearestUnvisited(0, 0), -1);
+}
+
+TEST(WaypointRouteTest, binaryFileRoundTrip)
+{
+  std::vector<geometry_msgs::Pose> reference;
+  for (int i = 0; i < 5000; i++)
+    reference.push_back(makePose(i * 0.1, (i % 11) * 0.2));
+
+  WaypointRoute route;
+  route.assign(reference);
+
+  std::string filepath = "/tmp/waypoint_route_test_" + std::to_string(getpid()) + ".bin";
+  ASSERT_TRUE(saveWaypointsBinary(filepath, route));
+
+  WaypointRoute loaded;
+  ASSERT_TRUE(loadWaypointsBinary(filepath, loaded));
+  expectSameRoute(loaded, reference);
+
+  // the loaded route is indexed too
+  EXPECT_EQ(loaded.nearestUnvisited(250.04, (2500 % 11) * 0.2), 2500);
+
+  std::remove(filepath.c_str());
+  EXPECT_FALSE(loadWaypointsBinary(filepath, loaded));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
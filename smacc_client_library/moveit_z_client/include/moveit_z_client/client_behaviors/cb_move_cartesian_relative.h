@@ -7,11 +7,12 @@
 #pragma once
 
 #include <moveit_z_client/cl_movegroup.h>
-#include <smacc/smacc_client_behavior.h>
+#include <smacc/smacc_asynchronous_client_behavior.h>
+#include <atomic>
 
 namespace moveit_z_client
 {
-class CbMoveCartesianRelative : public smacc::SmaccClientBehavior
+class CbMoveCartesianRelative : public smacc::SmaccAsyncClientBehavior
 {
 public:
   geometry_msgs::Vector3 offset_;
@@ -28,10 +29,14 @@ public:
 
   virtual void onExit() override;
 
-  void moveRelativeCartesian(moveit::planning_interface::MoveGroupInterface *movegroupClient,
+  // returns true if the motion was planned and executed successfully
+  bool moveRelativeCartesian(moveit::planning_interface::MoveGroupInterface *movegroupClient,
                              geometry_msgs::Vector3 &offset);
 
   public:
     ClMoveGroup *moveGroupSmaccClient_;
+
+private:
+  std::atomic<bool> motionRunning_;
 };
 }  // namespace moveit_z_client
\ No newline at end of file
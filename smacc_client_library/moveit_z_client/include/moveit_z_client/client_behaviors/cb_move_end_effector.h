@@ -7,11 +7,12 @@
 #pragma once
 
 #include <moveit_z_client/cl_movegroup.h>
-#include <smacc/smacc_client_behavior.h>
+#include <smacc/smacc_asynchronous_client_behavior.h>
+#include <atomic>
 #include <future>
 namespace moveit_z_client
 {
-class CbMoveEndEffector : public smacc::SmaccClientBehavior, public smacc::ISmaccUpdatable
+class CbMoveEndEffector : public smacc::SmaccAsyncClientBehavior, public smacc::ISmaccUpdatable
 {
 public:
   geometry_msgs::PoseStamped targetPose;
@@ -27,9 +28,13 @@ public:
   std::future<moveit::planning_interface::MoveItErrorCode> planAndExecuteAsync();
 
 protected:
+  // returns true if the motion was planned and executed successfully
   bool moveToAbsolutePose(moveit::planning_interface::MoveGroupInterface &moveGroupInterface,
                           geometry_msgs::PoseStamped &targetObjectPose);
 
   ClMoveGroup *movegroupClient_;
+
+private:
+  std::atomic<bool> motionRunning_;
 };
 }  // namespace moveit_z_client
\ No newline at end of file
@@ -7,11 +7,12 @@
 #pragma once
 
 #include <moveit_z_client/cl_movegroup.h>
-#include <smacc/smacc_client_behavior.h>
+#include <smacc/smacc_asynchronous_client_behavior.h>
+#include <atomic>
 
 namespace moveit_z_client
 {
-class CbMoveEndEffectorRelative : public smacc::SmaccClientBehavior
+class CbMoveEndEffectorRelative : public smacc::SmaccAsyncClientBehavior
 {
 public:
   geometry_msgs::Transform transform_;
@@ -27,10 +28,14 @@ public:
   virtual void onExit() override;
 
 protected:
-  void moveRelative(moveit::planning_interface::MoveGroupInterface &moveGroupinterface,
+  // returns true if the motion was planned and executed successfully
+  bool moveRelative(moveit::planning_interface::MoveGroupInterface &moveGroupinterface,
                     geometry_msgs::Transform &transformOffset);
 
   ClMoveGroup *movegroupClient_;
+
+private:
+  std::atomic<bool> motionRunning_;
 };
 
 }  // namespace moveit_z_client
\ No newline at end of file
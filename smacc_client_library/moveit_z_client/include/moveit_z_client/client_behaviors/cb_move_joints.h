@@ -7,13 +7,14 @@
 #pragma once
 
 #include <moveit_z_client/cl_movegroup.h>
-#include <smacc/smacc_client_behavior.h>
+#include <smacc/smacc_asynchronous_client_behavior.h>
+#include <atomic>
 #include <map>
 #include <string>
 
 namespace moveit_z_client
 {
-class CbMoveJoints : public smacc::SmaccClientBehavior
+class CbMoveJoints : public smacc::SmaccAsyncClientBehavior
 {
 public:
   boost::optional<double> scalingFactor_;
@@ -26,8 +27,11 @@ public:
   virtual void onExit() override;
 
 protected:
-  void moveJoints(moveit::planning_interface::MoveGroupInterface &moveGroupInterface);
+  // returns true if the motion was planned and executed successfully
+  bool moveJoints(moveit::planning_interface::MoveGroupInterface &moveGroupInterface);
   ClMoveGroup *movegroupClient_;
 
-  };
+private:
+  std::atomic<bool> motionRunning_;
+};
 }  // namespace moveit_z_client
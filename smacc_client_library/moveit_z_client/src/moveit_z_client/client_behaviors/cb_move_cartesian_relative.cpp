@@ -5,43 +5,65 @@
  ******************************************************************************************************************/
 
 #include <moveit_z_client/client_behaviors/cb_move_cartesian_relative.h>
-#include <future>
 
 namespace moveit_z_client
 {
-CbMoveCartesianRelative::CbMoveCartesianRelative()
+CbMoveCartesianRelative::CbMoveCartesianRelative() : motionRunning_(false)
 {
 }
 
-CbMoveCartesianRelative::CbMoveCartesianRelative(geometry_msgs::Vector3 offset) : offset_(offset)
+CbMoveCartesianRelative::CbMoveCartesianRelative(geometry_msgs::Vector3 offset) : offset_(offset), motionRunning_(false)
 {
 }
 
 void CbMoveCartesianRelative::onEntry()
 {
   this->requiresClient(moveGroupSmaccClient_);
+  motionRunning_ = true;
+
+  // the result event is posted from the continuation, so it is discarded if the state was left meanwhile
+  auto onMotionDone = [=](const bool& success) {
+    if (success)
+      moveGroupSmaccClient_->postEventMotionExecutionSucceded();
+    else
+      moveGroupSmaccClient_->postEventMotionExecutionFailed();
+  };
 
   if (this->group_)
   {
-    auto res = std::async(std::launch::async, [=] {
-      moveit::planning_interface::MoveGroupInterface move_group(*(this->group_));
-      this->moveRelativeCartesian(&move_group, offset_);
-    });
+    this->runAsync<bool>(
+        [=] {
+          moveit::planning_interface::MoveGroupInterface move_group(*(this->group_));
+          bool success = this->moveRelativeCartesian(&move_group, offset_);
+          motionRunning_ = false;
+          return success;
+        },
+        onMotionDone);
   }
   else
   {
-    auto res = std::async(std::launch::async, [=] {
-      this->moveRelativeCartesian(&moveGroupSmaccClient_->moveGroupClientInterface, offset_);
-    });
+    this->runAsync<bool>(
+        [=] {
+          bool success = this->moveRelativeCartesian(&moveGroupSmaccClient_->moveGroupClientInterface, offset_);
+          motionRunning_ = false;
+          return success;
+        },
+        onMotionDone);
   }
 }
 
 void CbMoveCartesianRelative::onExit()
 {
+  // the stop request cancels the trajectory execution in move_group, also the one of a private group interface
+  if (motionRunning_)
+  {
+    ROS_INFO("[CbMoveCartesianRelative] state left with the motion running, stopping it");
+    moveGroupSmaccClient_->moveGroupClientInterface.stop();
+  }
 }
 
 // keeps the end efector orientation fixed
-void CbMoveCartesianRelative::moveRelativeCartesian(moveit::planning_interface::MoveGroupInterface *movegroupClient,
+bool CbMoveCartesianRelative::moveRelativeCartesian(moveit::planning_interface::MoveGroupInterface *movegroupClient,
                                                     geometry_msgs::Vector3 &offset)
 {
   std::vector<geometry_msgs::Pose> waypoints;
@@ -83,9 +105,8 @@ void CbMoveCartesianRelative::moveRelativeCartesian(moveit::planning_interface::
 
   if (fraction == -1)
   {
-    moveGroupSmaccClient_->postEventMotionExecutionFailed();
     ROS_INFO("[CbMoveCartesianRelative] Absolute motion planning failed. Skipping execution.");
-    return;
+    return false;
   }
   else if (fraction != 1.0)
   {
@@ -102,17 +123,17 @@ void CbMoveCartesianRelative::moveRelativeCartesian(moveit::planning_interface::
   grasp_pose_plan.trajectory_ = trajectory;
   auto executionResult = movegroupClient->execute(grasp_pose_plan);
 
-  if (executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS)
+  bool success = executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS;
+  if (success)
   {
     ROS_INFO("[CbMoveCartesianRelative] relative motion execution succedded: fraction %lf.", fraction);
-    moveGroupSmaccClient_->postEventMotionExecutionSucceded();
   }
   else
   {
     ROS_INFO("[CbMoveCartesianRelative] relative motion execution failed");
-    moveGroupSmaccClient_->postEventMotionExecutionFailed();
   }
 
   ROS_INFO("Visualizing plan 4 (cartesian path) (%.2f%% acheived)", fraction * 100.0);
+  return success;
 }
 }  // namespace moveit_z_client
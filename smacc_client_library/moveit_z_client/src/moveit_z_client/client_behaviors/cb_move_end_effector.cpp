@@ -11,12 +11,12 @@
 
 namespace moveit_z_client
 {
-CbMoveEndEffector::CbMoveEndEffector()
+CbMoveEndEffector::CbMoveEndEffector() : motionRunning_(false)
 {
 }
 
 CbMoveEndEffector::CbMoveEndEffector(geometry_msgs::PoseStamped target_pose, std::string tip_link)
-  : targetPose(target_pose)
+  : targetPose(target_pose), motionRunning_(false)
 {
   tip_link_ = tip_link;
 }
@@ -24,28 +24,51 @@ CbMoveEndEffector::CbMoveEndEffector(geometry_msgs::PoseStamped target_pose, std
 void CbMoveEndEffector::onEntry()
 {
   this->requiresClient(movegroupClient_);
+  motionRunning_ = true;
+
+  // the result event is posted from the continuation, so it is discarded if the state was left meanwhile
+  auto onMotionDone = [=](const bool &success) {
+    if (success)
+      movegroupClient_->postEventMotionExecutionSucceded();
+    else
+      movegroupClient_->postEventMotionExecutionFailed();
+  };
 
   if (this->group_)
   {
-    auto res = std::async(std::launch::async, [=] {
-      ROS_DEBUG("[CbMoveEndEfector] new thread started to move absolute end effector");
-      moveit::planning_interface::MoveGroupInterface move_group(*(this->group_));
-      this->moveToAbsolutePose(move_group, targetPose);
-      ROS_DEBUG("[CbMoveEndEfector] to move absolute end effector thread destroyed");
-    });
+    this->runAsync<bool>(
+        [=] {
+          ROS_DEBUG("[CbMoveEndEfector] new thread started to move absolute end effector");
+          moveit::planning_interface::MoveGroupInterface move_group(*(this->group_));
+          bool success = this->moveToAbsolutePose(move_group, targetPose);
+          motionRunning_ = false;
+          ROS_DEBUG("[CbMoveEndEfector] to move absolute end effector thread destroyed");
+          return success;
+        },
+        onMotionDone);
   }
   else
   {
-    auto res = std::async(std::launch::async, [=] {
-      ROS_DEBUG("[CbMoveEndEfector] new thread started to move absolute end effector");
-      this->moveToAbsolutePose(movegroupClient_->moveGroupClientInterface, targetPose);
-      ROS_DEBUG("[CbMoveEndEfector] to move absolute end effector thread destroyed");
-    });
+    this->runAsync<bool>(
+        [=] {
+          ROS_DEBUG("[CbMoveEndEfector] new thread started to move absolute end effector");
+          bool success = this->moveToAbsolutePose(movegroupClient_->moveGroupClientInterface, targetPose);
+          motionRunning_ = false;
+          ROS_DEBUG("[CbMoveEndEfector] to move absolute end effector thread destroyed");
+          return success;
+        },
+        onMotionDone);
   }
 }
 
 void CbMoveEndEffector::onExit()
 {
+  // the stop request cancels the trajectory execution in move_group, also the one of a private group interface
+  if (motionRunning_)
+  {
+    ROS_INFO("[CbMoveEndEffector] state left with the motion running, stopping it");
+    movegroupClient_->moveGroupClientInterface.stop();
+  }
 }
 
 void CbMoveEndEffector::update()
@@ -73,24 +96,11 @@ bool CbMoveEndEffector::moveToAbsolutePose(moveit::planning_interface::MoveGroup
   if (success)
   {
     auto executionResult = moveGroupInterface.execute(computedMotionPlan);
-
-    if (executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS)
-    {
-      ROS_INFO("[CbMoveEndEffector] motion execution succedded");
-      movegroupClient_->postEventMotionExecutionSucceded();
-    }
-    else
-    {
-      ROS_INFO("[CbMoveEndEffector] motion execution failed");
-      movegroupClient_->postEventMotionExecutionFailed();
-    }
-  }
-  else
-  {
-    ROS_INFO("[CbMoveEndEffector] motion execution failed");
-    movegroupClient_->postEventMotionExecutionFailed();
+    success = executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS;
   }
 
+  ROS_INFO("[CbMoveEndEffector] motion execution %s", success ? "succedded" : "failed");
+
   ROS_DEBUG("[CbMoveEndEffector] Synchronous sleep of 1 seconds");
   ros::WallDuration(1).sleep();
 
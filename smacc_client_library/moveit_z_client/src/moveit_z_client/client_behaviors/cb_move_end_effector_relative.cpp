@@ -7,16 +7,17 @@
 #include <moveit_z_client/client_behaviors/cb_move_end_effector_relative.h>
 #include <tf/tf.h>
 #include <tf/transform_datatypes.h>
-#include <future>
 
 namespace moveit_z_client
 {
 CbMoveEndEffectorRelative::CbMoveEndEffectorRelative()
+    : motionRunning_(false)
 {
     transform_.rotation.w = 1;
 }
 
 CbMoveEndEffectorRelative::CbMoveEndEffectorRelative(geometry_msgs::Transform transform)
+    : motionRunning_(false)
 {
 }
 
@@ -25,29 +26,50 @@ void CbMoveEndEffectorRelative::onEntry()
     ROS_INFO_STREAM("[CbMoveEndEffectorRelative] Transform end effector pose relative: " << transform_);
 
     this->requiresClient(movegroupClient_);
+    motionRunning_ = true;
+
+    // the result event is posted from the continuation, so it is discarded if the state was left meanwhile
+    auto onMotionDone = [=](const bool &success) {
+        if (success)
+            movegroupClient_->postEventMotionExecutionSucceded();
+        else
+            movegroupClient_->postEventMotionExecutionFailed();
+    };
 
     if (this->group_)
     {
-        auto res = std::async(std::launch::async, [=] 
-        {
+        this->runAsync<bool>(
+            [=] {
                 moveit::planning_interface::MoveGroupInterface move_group(*(this->group_));
-                this->moveRelative(move_group, this->transform_);
-        });
+                bool success = this->moveRelative(move_group, this->transform_);
+                motionRunning_ = false;
+                return success;
+            },
+            onMotionDone);
     }
     else
     {
-        auto res = std::async(std::launch::async, [=] 
-        {
-            this->moveRelative(movegroupClient_->moveGroupClientInterface, this->transform_);
-        });
+        this->runAsync<bool>(
+            [=] {
+                bool success = this->moveRelative(movegroupClient_->moveGroupClientInterface, this->transform_);
+                motionRunning_ = false;
+                return success;
+            },
+            onMotionDone);
     }
 }
 
 void CbMoveEndEffectorRelative::onExit()
 {
+    // the stop request cancels the trajectory execution in move_group, also the one of a private group interface
+    if (motionRunning_)
+    {
+        ROS_INFO("[CbMoveEndEffectorRelative] state left with the motion running, stopping it");
+        movegroupClient_->moveGroupClientInterface.stop();
+    }
 }
 
-void CbMoveEndEffectorRelative::moveRelative(moveit::planning_interface::MoveGroupInterface& moveGroupInterface, geometry_msgs::Transform &transformOffset)
+bool CbMoveEndEffectorRelative::moveRelative(moveit::planning_interface::MoveGroupInterface& moveGroupInterface, geometry_msgs::Transform &transformOffset)
 {
     auto referenceStartPose = moveGroupInterface.getCurrentPose();
     tf::Quaternion currentOrientation;
@@ -79,22 +101,10 @@ void CbMoveEndEffectorRelative::moveRelative(moveit::planning_interface::MoveGro
     if (success)
     {
         auto executionResult = moveGroupInterface.execute(computedMotionPlan);
-
-        if (executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS)
-        {
-            ROS_INFO("[CbMoveEndEffectorRelative] motion execution succedded");
-            movegroupClient_->postEventMotionExecutionSucceded();
-        }
-        else
-        {
-            ROS_INFO("[CbMoveEndEffectorRelative] motion execution failed");
-            movegroupClient_->postEventMotionExecutionFailed();
-        }
-    }
-    else
-    {
-        ROS_INFO("[CbMoveEndEffectorRelative] motion execution failed");
-        movegroupClient_->postEventMotionExecutionFailed();
+        success = executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS;
     }
+
+    ROS_INFO("[CbMoveEndEffectorRelative] motion execution %s", success ? "succedded" : "failed");
+    return success;
 }
 } // namespace moveit_z_client
\ No newline at end of file
@@ -5,37 +5,55 @@
  ******************************************************************************************************************/
 
 #include <moveit_z_client/client_behaviors/cb_move_joints.h>
-#include <future>
 
 namespace moveit_z_client
 {
-CbMoveJoints::CbMoveJoints(const std::map<std::string, double>& jointValueTarget) : jointValueTarget_(jointValueTarget)
+CbMoveJoints::CbMoveJoints(const std::map<std::string, double>& jointValueTarget)
+  : jointValueTarget_(jointValueTarget), motionRunning_(false)
 {
 }
 
-CbMoveJoints::CbMoveJoints()
+CbMoveJoints::CbMoveJoints() : motionRunning_(false)
 {
 }
 
 void CbMoveJoints::onEntry()
 {
   this->requiresClient(movegroupClient_);
+  motionRunning_ = true;
+
+  // the result event is posted from the continuation, so it is discarded if the state was left meanwhile
+  auto onMotionDone = [=](const bool& success) {
+    if (success)
+      movegroupClient_->postEventMotionExecutionSucceded();
+    else
+      movegroupClient_->postEventMotionExecutionFailed();
+  };
 
   if (this->group_)
   {
-    auto res = std::async(std::launch::async, [=] {
-      moveit::planning_interface::MoveGroupInterface move_group(*(this->group_));
-      this->moveJoints(move_group);
-    });
+    this->runAsync<bool>(
+        [=] {
+          moveit::planning_interface::MoveGroupInterface move_group(*(this->group_));
+          bool success = this->moveJoints(move_group);
+          motionRunning_ = false;
+          return success;
+        },
+        onMotionDone);
   }
   else
   {
-    auto res =
-        std::async(std::launch::async, [=] { this->moveJoints(movegroupClient_->moveGroupClientInterface); });
+    this->runAsync<bool>(
+        [=] {
+          bool success = this->moveJoints(movegroupClient_->moveGroupClientInterface);
+          motionRunning_ = false;
+          return success;
+        },
+        onMotionDone);
   }
 }
 
-void CbMoveJoints::moveJoints(moveit::planning_interface::MoveGroupInterface& moveGroupInterface)
+bool CbMoveJoints::moveJoints(moveit::planning_interface::MoveGroupInterface& moveGroupInterface)
 {
   if (scalingFactor_)
     moveGroupInterface.setMaxVelocityScalingFactor(*scalingFactor_);
@@ -50,26 +68,20 @@ void CbMoveJoints::moveJoints(moveit::planning_interface::MoveGroupInterface& mo
   if (success)
   {
     auto executionResult = moveGroupInterface.execute(computedMotionPlan);
-
-    if (executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS)
-    {
-      ROS_INFO("[CbMoveJoints] motion execution succedded");
-      movegroupClient_->postEventMotionExecutionSucceded();
-    }
-    else
-    {
-      ROS_INFO("[CbMoveJoints] motion execution failed");
-      movegroupClient_->postEventMotionExecutionFailed();
-    }
-  }
-  else
-  {
-    ROS_INFO("[CbMoveJoints] motion execution failed");
-    movegroupClient_->postEventMotionExecutionFailed();
+    success = executionResult == moveit_msgs::MoveItErrorCodes::SUCCESS;
   }
+
+  ROS_INFO("[CbMoveJoints] motion execution %s", success ? "succedded" : "failed");
+  return success;
 }
 
 void CbMoveJoints::onExit()
 {
+  // the stop request cancels the trajectory execution in move_group, also the one of a private group interface
+  if (motionRunning_)
+  {
+    ROS_INFO("[CbMoveJoints] state left with the motion running, stopping it");
+    movegroupClient_->moveGroupClientInterface.stop();
+  }
 }
 }  // namespace moveit_z_client
\ No newline at end of file
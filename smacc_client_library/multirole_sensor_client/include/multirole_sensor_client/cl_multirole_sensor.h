@@ -1,6 +1,7 @@
 #pragma once
 
 #include <smacc/client_bases/smacc_subscriber_client.h>
+#include <smacc/smacc_timer_wheel.h>
 #include <boost/statechart/event.hpp>
 
 #include <ros/ros.h>
@@ -67,8 +68,7 @@ public:
 
       if (timeout_)
       {
-        timeoutTimer_ = this->nh_.createTimer(*timeout_, boost::bind(&ClMultiroleSensor<MessageType>::timeoutCallback, this, _1));
-        timeoutTimer_.start();
+        timeoutWatchdog_.start(*timeout_, [this]() { this->timeoutCallback(); });
       }
       else
       {
@@ -84,17 +84,25 @@ public:
 protected:
   void resetTimer(const MessageType &msg)
   {
-    //reseting the timer
-    this->timeoutTimer_.stop();
-    this->timeoutTimer_.start();
+    // only stores the reception time, the watchdog checks it when the timeout expires
+    this->timeoutWatchdog_.feed();
   }
 
 private:
-  ros::Timer timeoutTimer_;
+  smacc::SmaccWatchdog timeoutWatchdog_;
   bool initialized_;
+  ros::Time lastTimeout_;
 
-  void timeoutCallback(const ros::TimerEvent &timerdata)
+  // called from the timer wheel thread
+  void timeoutCallback()
   {
+    ros::TimerEvent timerdata;
+    timerdata.current_real = ros::Time::now();
+    timerdata.current_expected = timerdata.current_real;
+    timerdata.last_real = lastTimeout_;
+    timerdata.last_expected = lastTimeout_;
+    lastTimeout_ = timerdata.current_real;
+
     postTimeoutMessageEvent(timerdata);
   }
 };
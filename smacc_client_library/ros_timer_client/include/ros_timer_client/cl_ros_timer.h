@@ -1,6 +1,7 @@
 #pragma once
 
 #include <smacc/smacc.h>
+#include <smacc/smacc_timer_wheel.h>
 #include <boost/signals2.hpp>
 #include <boost/optional/optional_io.hpp>
 
@@ -47,11 +48,12 @@ public:
 protected:
     ros::NodeHandle nh_;
 
-    ros::Timer timer;
+    // the timer is served by the shared smacc timer wheel instead of a ros::Timer per client
+    smacc::TimerWheel::TimerId timer;
     ros::Duration duration;
     bool oneshot;
 
-    void timerCallback(const ros::TimerEvent &timedata);
+    void timerCallback();
     std::function<void()> postTimerEvent_;
     smacc::SmaccSignal<void()> onTimerTick_;
 };
@@ -4,6 +4,7 @@ namespace cl_ros_timer
 {
 
 ClRosTimer::ClRosTimer(ros::Duration duration, bool oneshot)
+    : timer(0)
 {
     this->duration = duration;
     this->oneshot = oneshot;
@@ -11,15 +12,17 @@ ClRosTimer::ClRosTimer(ros::Duration duration, bool oneshot)
 
 ClRosTimer::~ClRosTimer()
 {
-    timer.stop();
+    if (timer != 0)
+        smacc::TimerWheel::getInstance().cancel(timer);
 }
 
 void ClRosTimer::initialize()
 {
-    timer = nh_.createTimer(duration, boost::bind(&ClRosTimer::timerCallback, this, _1), oneshot);
+    timer = smacc::TimerWheel::getInstance().schedule(duration, [this]() { this->timerCallback(); },
+                                                      oneshot ? ros::Duration(0) : duration);
 }
 
-void ClRosTimer::timerCallback(const ros::TimerEvent &timedata)
+void ClRosTimer::timerCallback()
 {
     if (!onTimerTick_.empty())
     {
@@ -44,7 +44,6 @@ public:
   int decissionsCount;
   int currentCube = 0;
 
-  tf::TransformListener tfListener_;
   tf::TransformBroadcaster tfBroadcaster_;
   ros::Subscriber gazeboStateSubscriber_;
   ros::Time lastUpdateStamp_;
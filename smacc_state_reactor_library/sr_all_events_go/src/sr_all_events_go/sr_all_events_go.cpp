@@ -18,24 +18,24 @@ void SrAllEventsGo::onInitialized()
 
 void SrAllEventsGo::onEventNotified(const std::type_info *eventType)
 {
-    ROS_INFO_STREAM("SB ALL RECEIVED EVENT OF TYPE:" << demangleSymbol(eventType->name()));
+    SMACC_LOG_INFO("SB ALL RECEIVED EVENT OF TYPE:{}", *eventType);
     triggeredEvents[eventType] = true;
 
     for (auto &entry : triggeredEvents)
     {
-        ROS_INFO_STREAM(demangleSymbol(entry.first->name()) << " = " << entry.second);
+        SMACC_LOG_INFO("{} = {}", *entry.first, entry.second);
     }
 }
 
 bool SrAllEventsGo::triggers()
 {
-    ROS_INFO("SB All TRIGGERS?");
+    SMACC_LOG_INFO("SB All TRIGGERS?");
     for (auto &entry : triggeredEvents)
     {
         if (!entry.second)
             return false;
     }
-    ROS_INFO("SB ALL TRIGGERED");
+    SMACC_LOG_INFO("SB ALL TRIGGERED");
     return true;
 }
 } // namespace state_reactors